@@ -0,0 +1,18 @@
+#!/bin/sh
+#
+# Run the benchmarks on a private Xvfb server
+#
+
+DISPLAY_NUM=${DISPLAY_NUM:-:99}
+
+make || exit 1
+
+Xvfb $DISPLAY_NUM -screen 0 720x1280x24 -nolisten tcp >/dev/null 2>&1 &
+XVFB_PID=$!
+sleep 1
+
+DISPLAY=$DISPLAY_NUM ./x_raise_bench $@
+RET=$?
+
+kill $XVFB_PID
+exit $RET
@@ -0,0 +1,290 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Resume latency benchmark for the raise_win() of the X module
+ *
+ * Creates an increasing number of windows on the X server and measures
+ * how long raise_win() and the idler it may defer the lookup to block
+ * the main loop, with and without the window cache which appcore-efl
+ * fills from the show/hide events. Without the cache, the window is
+ * looked up through _NET_CLIENT_LIST which is maintained here the way a
+ * window manager would do.
+ *
+ * The baseline column is the x_raise_win() of app-core 1.1, kept below:
+ * a new connection and a walk of the whole window tree on every resume.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#include <X11/Xlib.h>
+#include <X11/Xatom.h>
+#include <glib.h>
+
+#include "appcore-internal.h"
+
+#define ITERATION 50
+#define ITERATION_BASELINE 5
+#define CLIENT_MAX 1024
+
+static Display *d;
+static Atom a_pid;
+static Atom a_client_list;
+static Window own;
+
+static Window clients[CLIENT_MAX];
+static int nclients;
+
+static void __set_pid(Window win, unsigned long pid)
+{
+	XChangeProperty(d, win, a_pid, XA_CARDINAL, 32, PropModeReplace,
+			(unsigned char *)&pid, 1);
+}
+
+/*
+ * Add a decoy which looks like what a window manager leaves on the server:
+ * a frame with a client of another process, an override-redirect popup
+ * and an input-only window.
+ */
+static void __add_decoy(Window root)
+{
+	Window frame;
+	Window client;
+	XSetWindowAttributes attr;
+
+	frame = XCreateSimpleWindow(d, root, 0, 0, 10, 10, 0, 0, 0);
+	client = XCreateSimpleWindow(d, frame, 0, 0, 10, 10, 0, 0, 0);
+	__set_pid(client, 1);
+	if (nclients < CLIENT_MAX - 1)
+		clients[nclients++] = client;
+
+	attr.override_redirect = True;
+	XCreateWindow(d, root, 0, 0, 10, 10, 0, CopyFromParent, InputOutput,
+		      CopyFromParent, CWOverrideRedirect, &attr);
+
+	XCreateWindow(d, root, 0, 0, 10, 10, 0, 0, InputOnly,
+		      CopyFromParent, 0, NULL);
+}
+
+static void __new_own_win(Window root)
+{
+	if (own) {
+		/* or the cache would still raise the destroyed window */
+		appcore_x_del_win(own);
+		XDestroyWindow(d, own);
+	}
+
+	own = XCreateSimpleWindow(d, root, 0, 0, 10, 10, 0, 0, 0);
+	__set_pid(own, getpid());
+	XMapWindow(d, own);
+
+	/* listed last, so the lookup meets it after every decoy */
+	clients[nclients] = own;
+	XChangeProperty(d, root, a_client_list, XA_WINDOW, 32,
+			PropModeReplace, (unsigned char *)clients,
+			nclients + 1);
+	XSync(d, False);
+}
+
+/* x_raise_win() before the X context and the window cache */
+static pid_t __old_get_win_pid(Display *dpy, Window win, Atom pid_atom)
+{
+	int r;
+	pid_t pid;
+
+	Atom a_type;
+	int format;
+	unsigned long nitems;
+	unsigned long bytes_after;
+	unsigned char *prop_ret;
+	XWindowAttributes attr;
+
+	if (!XGetWindowAttributes(dpy, win, &attr))
+		return -1;
+
+	if (attr.override_redirect || attr.class == InputOnly)
+		return -1;
+
+	prop_ret = NULL;
+	r = XGetWindowProperty(dpy, win, pid_atom, 0, 1, False, XA_CARDINAL,
+			       &a_type, &format, &nitems, &bytes_after,
+			       &prop_ret);
+	if (r != Success || prop_ret == NULL)
+		return -1;
+
+	if (a_type == XA_CARDINAL && format == 32)
+		pid = *(unsigned long *)prop_ret;
+	else
+		pid = -1;
+
+	XFree(prop_ret);
+
+	return pid;
+}
+
+static int __old_find_win(Display *dpy, Window *win, pid_t pid,
+			  Atom pid_atom)
+{
+	int r;
+	int i;
+	int found;
+	unsigned int n;
+	Window root, parent, *child;
+
+	if (__old_get_win_pid(dpy, *win, pid_atom) == pid)
+		return 1;
+
+	r = XQueryTree(dpy, *win, &root, &parent, &child, &n);
+	if (!r)
+		return 0;
+
+	found = 0;
+	for (i = 0; i < n; i++) {
+		found = __old_find_win(dpy, &child[i], pid, pid_atom);
+		if (found) {
+			*win = child[i];
+			break;
+		}
+	}
+	XFree(child);
+
+	return found;
+}
+
+static int __old_raise_win(pid_t pid)
+{
+	Display *dpy;
+	Window win;
+	Atom pid_atom;
+	XEvent xev;
+
+	dpy = XOpenDisplay(NULL);
+	if (dpy == NULL)
+		return -1;
+
+	win = XDefaultRootWindow(dpy);
+	pid_atom = XInternAtom(dpy, "_NET_WM_PID", True);
+
+	if (!__old_find_win(dpy, &win, pid, pid_atom)) {
+		XCloseDisplay(dpy);
+		return -1;
+	}
+
+	memset(&xev, 0, sizeof(xev));
+	xev.xclient.type = ClientMessage;
+	xev.xclient.display = dpy;
+	xev.xclient.window = win;
+	xev.xclient.message_type =
+	    XInternAtom(dpy, "_NET_ACTIVE_WINDOW", False);
+	xev.xclient.format = 32;
+	xev.xclient.data.l[0] = 1;
+	XSendEvent(dpy, XDefaultRootWindow(dpy), False,
+		   SubstructureRedirectMask | SubstructureNotifyMask, &xev);
+
+	XCloseDisplay(dpy);
+
+	return 0;
+}
+
+static double __measure_baseline(void)
+{
+	int i;
+	struct timeval s;
+	struct timeval e;
+
+	gettimeofday(&s, NULL);
+	for (i = 0; i < ITERATION_BASELINE; i++) {
+		if (__old_raise_win(getpid())) {
+			fprintf(stderr, "baseline raise failed\n");
+			exit(1);
+		}
+	}
+	gettimeofday(&e, NULL);
+
+	return ((e.tv_sec - s.tv_sec) * 1000000.0 +
+		(e.tv_usec - s.tv_usec)) / ITERATION_BASELINE;
+}
+
+static double __measure(void)
+{
+	int i;
+	struct timeval s;
+	struct timeval e;
+
+	gettimeofday(&s, NULL);
+	for (i = 0; i < ITERATION; i++) {
+		if (appcore_x_module.raise_win(getpid())) {
+			fprintf(stderr, "raise_win failed\n");
+			exit(1);
+		}
+		/* the lookup is deferred to an idler */
+		while (g_main_context_iteration(NULL, FALSE))
+			;
+	}
+	gettimeofday(&e, NULL);
+
+	return ((e.tv_sec - s.tv_sec) * 1000000.0 +
+		(e.tv_usec - s.tv_usec)) / ITERATION;
+}
+
+int main(int argc, char *argv[])
+{
+	int n;
+	int total;
+	Window root;
+
+	d = XOpenDisplay(NULL);
+	if (d == NULL) {
+		fprintf(stderr, "cannot open display\n");
+		return 1;
+	}
+
+	root = XDefaultRootWindow(d);
+	a_pid = XInternAtom(d, "_NET_WM_PID", False);
+	a_client_list = XInternAtom(d, "_NET_CLIENT_LIST", False);
+
+	printf("%8s %14s %14s %14s\n", "windows", "baseline(usec)",
+	       "lookup(usec)", "cached(usec)");
+
+	total = 0;
+	for (n = 16; n <= (argc > 1 ? atoi(argv[1]) : 4096); n *= 4) {
+		for (; total < n; total += 4)
+			__add_decoy(root);
+		__new_own_win(root);
+
+		printf("%8d %14.1f", total, __measure_baseline());
+
+		appcore_x_del_win(own);
+		printf(" %14.1f", __measure());
+
+		appcore_x_add_win(own);
+		printf(" %14.1f\n", __measure());
+	}
+
+	appcore_x_module.exit();
+	XCloseDisplay(d);
+
+	return 0;
+}
@@ -0,0 +1,414 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <tet_api.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <appcore-common.h>
+
+/*
+ * The catalog code is built into the test, which writes the .mo files it
+ * maps: hashed in both byte orders, without a hash table, and broken ones.
+ */
+#include "../../src/appcore-catalog.c"
+
+static void startup(void);
+static void cleanup(void);
+
+void (*tet_startup)(void) = startup;
+void (*tet_cleanup)(void) = cleanup;
+
+static void utc_ApplicationFW_appcore_catalog_mo_func_01(void);
+static void utc_ApplicationFW_appcore_catalog_mo_func_02(void);
+static void utc_ApplicationFW_appcore_catalog_mo_func_03(void);
+static void utc_ApplicationFW_appcore_catalog_mo_func_04(void);
+static void utc_ApplicationFW_appcore_catalog_mo_func_05(void);
+
+enum {
+	POSITIVE_TC_IDX = 0x01,
+	NEGATIVE_TC_IDX,
+};
+
+struct tet_testlist tet_testlist[] = {
+	{ utc_ApplicationFW_appcore_catalog_mo_func_01, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_catalog_mo_func_02, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_catalog_mo_func_03, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_catalog_mo_func_04, NEGATIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_catalog_mo_func_05, NEGATIVE_TC_IDX },
+	{ NULL, 0},
+};
+
+#define DOMAIN "Testcase"
+#define NMSG 500
+#define NENT (NMSG + 1)		/* the messages and a plural */
+
+/* the plural form follows the NUL */
+#define PLURAL "%d file\0%d files"
+#define PLURAL_TR "%d Datei\0%d Dateien"
+
+#define MO_HASHED 0x01
+#define MO_SWAPPED 0x02
+
+#define HDR_SIZE 28
+#define ORIG_OFF HDR_SIZE
+#define TRANS_OFF (ORIG_OFF + 8 * NENT)
+#define HASH_OFF (TRANS_OFF + 8 * NENT)
+
+static char dir[] = "/tmp/appcore-mo-XXXXXX";
+static char *langs[16];
+static int nlangs;
+
+static unsigned int __word(unsigned int v, int flags)
+{
+	return (flags & MO_SWAPPED) ? __builtin_bswap32(v) : v;
+}
+
+static unsigned int __prime(unsigned int n)
+{
+	unsigned int d;
+
+	for (;; n++) {
+		for (d = 2; d * d <= n && n % d; d++)
+			;
+		if (d * d > n)
+			return n;
+	}
+}
+
+/* entry i of the catalog, in the order msgfmt sorts them */
+static void __entry(int i, char *id, size_t *id_len, char *tr, size_t *tr_len)
+{
+	if (i == 0) {
+		memcpy(id, PLURAL, sizeof(PLURAL));
+		memcpy(tr, PLURAL_TR, sizeof(PLURAL_TR));
+		*id_len = sizeof(PLURAL) - 1;
+		*tr_len = sizeof(PLURAL_TR) - 1;
+		return;
+	}
+
+	*id_len = sprintf(id, "msg%03d", i - 1);
+	*tr_len = sprintf(tr, "trans%03d", i - 1);
+}
+
+static unsigned int __hash_size(int flags)
+{
+	return (flags & MO_HASHED) ? __prime(NENT * 4 / 3) : 0;
+}
+
+/* a catalog laid out as msgfmt writes it */
+static char *__build(int flags, size_t *size)
+{
+	unsigned int hsize = __hash_size(flags);
+	unsigned int *w;
+	unsigned int *hash;
+	unsigned int off;
+	unsigned int h;
+	unsigned int idx;
+	unsigned int incr;
+	char id[32];
+	char tr[32];
+	size_t id_len;
+	size_t tr_len;
+	char *buf;
+	int i;
+
+	off = HASH_OFF + 4 * hsize;
+	buf = calloc(1, off + NENT * 2 * sizeof(id));
+	if (buf == NULL)
+		return NULL;
+
+	w = (unsigned int *)buf;
+	w[0] = __word(MO_MAGIC, flags);
+	w[2] = __word(NENT, flags);
+	w[3] = __word(ORIG_OFF, flags);
+	w[4] = __word(TRANS_OFF, flags);
+	w[5] = __word(hsize, flags);
+	w[6] = __word(HASH_OFF, flags);
+
+	hash = (unsigned int *)(buf + HASH_OFF);
+	for (i = 0; i < NENT; i++) {
+		__entry(i, id, &id_len, tr, &tr_len);
+
+		w[ORIG_OFF / 4 + 2 * i] = __word(id_len, flags);
+		w[ORIG_OFF / 4 + 2 * i + 1] = __word(off, flags);
+		memcpy(buf + off, id, id_len + 1);
+		off += id_len + 1;
+
+		w[TRANS_OFF / 4 + 2 * i] = __word(tr_len, flags);
+		w[TRANS_OFF / 4 + 2 * i + 1] = __word(off, flags);
+		memcpy(buf + off, tr, tr_len + 1);
+		off += tr_len + 1;
+
+		if (hsize == 0)
+			continue;
+
+		h = __hash(id);
+		idx = h % hsize;
+		incr = 1 + (h % (hsize - 2));
+		while (hash[idx]) {
+			if (idx >= hsize - incr)
+				idx -= hsize - incr;
+			else
+				idx += incr;
+		}
+		hash[idx] = __word(i + 1, flags);
+	}
+
+	*size = off;
+
+	return buf;
+}
+
+/* writes <dir>/<lang>/LC_MESSAGES/<domain>.mo and switches to lang */
+static int __use(const char *lang, const char *buf, size_t size)
+{
+	char path[PATH_MAX];
+	FILE *fp;
+	size_t r;
+
+	snprintf(path, sizeof(path), "%s/%s", dir, lang);
+	if (mkdir(path, 0755) == -1)
+		return -1;
+	langs[nlangs++] = strdup(lang);
+
+	strncat(path, "/LC_MESSAGES", sizeof(path) - strlen(path) - 1);
+	if (mkdir(path, 0755) == -1)
+		return -1;
+
+	strncat(path, "/" DOMAIN ".mo", sizeof(path) - strlen(path) - 1);
+	fp = fopen(path, "w");
+	if (fp == NULL)
+		return -1;
+	r = fwrite(buf, 1, size, fp);
+	if (fclose(fp) || r != size)
+		return -1;
+
+	catalog_set_lang(lang);
+
+	return 0;
+}
+
+/* the caller's string if no catalog is mapped */
+static const char *__find(const char *msgid)
+{
+	const char *s;
+
+	s = catalog_find(msgid);
+
+	return s ? : msgid;
+}
+
+/* the number of entries translated, -1 if a lookup gave a wrong string */
+static int __translated(void)
+{
+	char id[32];
+	char tr[32];
+	size_t id_len;
+	size_t tr_len;
+	const char *s;
+	int n = 0;
+	int i;
+
+	for (i = 0; i < NENT; i++) {
+		__entry(i, id, &id_len, tr, &tr_len);
+
+		s = __find(id);
+		if (s && !strcmp(s, tr))
+			n++;
+		else if (s != id)
+			return -1;
+	}
+
+	/* not in the catalog */
+	s = __find("msg500");
+	if (s == NULL || strcmp(s, "msg500"))
+		return -1;
+
+	return n;
+}
+
+static void __check(const char *lang, int flags)
+{
+	char *buf;
+	size_t size;
+	int r;
+
+	buf = __build(flags, &size);
+	if (buf == NULL || __use(lang, buf, size)) {
+		free(buf);
+		tet_infoline("cannot write the catalog");
+		tet_result(TET_UNRESOLVED);
+		return;
+	}
+	free(buf);
+
+	r = __translated();
+	if (r != NENT || cur == NULL || cur->map == NULL ||
+	    !cur->hash != !(flags & MO_HASHED)) {
+		tet_infoline("catalog_find() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+static void startup(void)
+{
+	if (mkdtemp(dir) == NULL)
+		return;
+
+	catalog_set_domain(DOMAIN, dir);
+}
+
+static void cleanup(void)
+{
+	char path[PATH_MAX];
+	int i;
+
+	for (i = 0; i < nlangs; i++) {
+		snprintf(path, sizeof(path), "%s/%s/LC_MESSAGES/" DOMAIN ".mo",
+			 dir, langs[i]);
+		unlink(path);
+		snprintf(path, sizeof(path), "%s/%s/LC_MESSAGES", dir, langs[i]);
+		rmdir(path);
+		snprintf(path, sizeof(path), "%s/%s", dir, langs[i]);
+		rmdir(path);
+		free(langs[i]);
+	}
+	rmdir(dir);
+}
+
+/**
+ * @brief Positive test case of catalog_find() with a hashed catalog
+ */
+static void utc_ApplicationFW_appcore_catalog_mo_func_01(void)
+{
+	__check("hashed", MO_HASHED);
+}
+
+/**
+ * @brief Positive test case of catalog_find() with a hashed catalog of the other byte order
+ */
+static void utc_ApplicationFW_appcore_catalog_mo_func_02(void)
+{
+	__check("swapped", MO_HASHED | MO_SWAPPED);
+}
+
+/**
+ * @brief Positive test case of catalog_find() with a catalog without a hash table
+ */
+static void utc_ApplicationFW_appcore_catalog_mo_func_03(void)
+{
+	__check("unhashed", 0);
+}
+
+/**
+ * @brief Negative test case of catalog_find() with truncated catalogs
+ */
+static void utc_ApplicationFW_appcore_catalog_mo_func_04(void)
+{
+	char *buf;
+	size_t size;
+	size_t strings;
+	int r1;
+	int r2;
+	int r3;
+
+	buf = __build(MO_HASHED, &size);
+	if (buf == NULL) {
+		tet_infoline("cannot write the catalog");
+		tet_result(TET_UNRESOLVED);
+		return;
+	}
+
+	/* in the header, not mapped */
+	r1 = __use("trunc_header", buf, HDR_SIZE - 4) ? -1 : __translated();
+
+	/* in the tables, not mapped */
+	r2 = __use("trunc_table", buf, TRANS_OFF + 4) ? -1 : __translated();
+
+	/* in the strings, only the first ones are found */
+	strings = HASH_OFF + 4 * __hash_size(MO_HASHED);
+	r3 = __use("trunc_strings", buf, strings + (size - strings) / 2) ?
+	     -1 : __translated();
+
+	free(buf);
+
+	if (r1 != 0 || r2 != 0 || r3 <= 0 || r3 >= NENT) {
+		tet_infoline("catalog_find() failed in negative test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Negative test case of catalog_find() with corrupt catalogs
+ */
+static void utc_ApplicationFW_appcore_catalog_mo_func_05(void)
+{
+	unsigned int *w;
+	char *buf;
+	size_t size;
+	int r1;
+	int r2;
+	int r3;
+	int r4;
+	int i;
+
+	buf = __build(MO_HASHED, &size);
+	if (buf == NULL) {
+		tet_infoline("cannot write the catalog");
+		tet_result(TET_UNRESOLVED);
+		return;
+	}
+	w = (unsigned int *)buf;
+
+	/* not a catalog */
+	w[0] = 0x12345678;
+	r1 = __use("bad_magic", buf, size) ? -1 : __translated();
+	w[0] = MO_MAGIC;
+
+	/* more strings than the file holds */
+	w[2] = 0x10000000;
+	r2 = __use("bad_count", buf, size) ? -1 : __translated();
+	w[2] = NENT;
+
+	/* the hash table points past the string tables */
+	for (i = 0; i < (int)__hash_size(MO_HASHED); i++)
+		w[HASH_OFF / 4 + i] = NENT + 1 + i;
+	r3 = __use("bad_hash", buf, size) ? -1 : __translated();
+
+	/* translations past the end of the file, searched without a table */
+	w[5] = 0;
+	for (i = 0; i < NENT; i++)
+		w[TRANS_OFF / 4 + 2 * i + 1] = size;
+	r4 = __use("bad_offset", buf, size) ? -1 : __translated();
+
+	free(buf);
+
+	if (r1 != 0 || r2 != 0 || r3 != 0 || r4 != 0) {
+		tet_infoline("catalog_find() failed in negative test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
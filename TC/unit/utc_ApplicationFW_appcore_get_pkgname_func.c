@@ -0,0 +1,82 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <tet_api.h>
+#include <string.h>
+#include <errno.h>
+#include <appcore-common.h>
+
+static void startup(void);
+static void cleanup(void);
+
+void (*tet_startup)(void) = startup;
+void (*tet_cleanup)(void) = cleanup;
+
+static void utc_ApplicationFW_appcore_get_pkgname_func_01(void);
+
+enum {
+	POSITIVE_TC_IDX = 0x01,
+	NEGATIVE_TC_IDX,
+};
+
+struct tet_testlist tet_testlist[] = {
+	{ utc_ApplicationFW_appcore_get_pkgname_func_01, POSITIVE_TC_IDX },
+	{ NULL, 0},
+};
+
+static void startup(void)
+{
+}
+
+static void cleanup(void)
+{
+}
+
+/**
+ * @brief Positive test case of appcore_get_pkgname()
+ */
+static void utc_ApplicationFW_appcore_get_pkgname_func_01(void)
+{
+	const char *pkg;
+	const char *res;
+
+	pkg = appcore_get_pkgname();
+	res = appcore_get_res_path();
+
+	/* the test runner may not be installed as a package */
+	if (pkg == NULL) {
+		if (errno != ENOENT || res != NULL) {
+			tet_infoline("appcore_get_pkgname() failed in positive test case");
+			tet_result(TET_FAIL);
+			return;
+		}
+		tet_result(TET_PASS);
+		return;
+	}
+
+	/* resolved once, the same result is returned */
+	if (pkg != appcore_get_pkgname() || res == NULL ||
+	    strstr(res, pkg) == NULL) {
+		tet_infoline("appcore_get_pkgname() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
@@ -0,0 +1,303 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <tet_api.h>
+#include <pthread.h>
+#include <appcore-common.h>
+
+/* the snapshot is built into the test with a vconf stand-in below */
+#include "../../src/appcore-settings.c"
+
+static void startup(void);
+static void cleanup(void);
+
+void (*tet_startup)(void) = startup;
+void (*tet_cleanup)(void) = cleanup;
+
+static void utc_ApplicationFW_appcore_get_settings_func_01(void);
+static void utc_ApplicationFW_appcore_get_settings_func_02(void);
+static void utc_ApplicationFW_appcore_get_settings_func_03(void);
+static void utc_ApplicationFW_appcore_get_settings_func_04(void);
+static void utc_ApplicationFW_appcore_get_settings_func_05(void);
+
+enum {
+	POSITIVE_TC_IDX = 0x01,
+	NEGATIVE_TC_IDX,
+};
+
+struct tet_testlist tet_testlist[] = {
+	{ utc_ApplicationFW_appcore_get_settings_func_01, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_get_settings_func_02, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_get_settings_func_03, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_get_settings_func_04, NEGATIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_get_settings_func_05, POSITIVE_TC_IDX },
+	{ NULL, 0},
+};
+
+#define LANG_A "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+#define LANG_B "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb"
+
+/* a key of the stand-in, passed as a keynode_t */
+struct node {
+	const char *name;
+	int i;
+	char *s;
+};
+
+static int v_timeformat = APPCORE_TIME_FORMAT_12;
+static int v_lock = 1;
+
+int vconf_get_int(const char *in_key, int *intval)
+{
+	if (!strcmp(in_key, VCONFKEY_REGIONFORMAT_TIME1224))
+		*intval = v_timeformat;
+	else
+		*intval = 1;
+
+	return 0;
+}
+
+int vconf_get_bool(const char *in_key, int *boolval)
+{
+	*boolval = v_lock;
+
+	return 0;
+}
+
+static int n_watch;
+
+int vconf_notify_key_changed(const char *in_key, vconf_callback_fn cb,
+			     void *user_data)
+{
+	n_watch++;
+
+	return 0;
+}
+
+int vconf_ignore_key_changed(const char *in_key, vconf_callback_fn cb)
+{
+	n_watch--;
+
+	return 0;
+}
+
+char *vconf_get_str(const char *in_key)
+{
+	if (!strcmp(in_key, VCONFKEY_LANGSET))
+		return strdup(LANG_A);
+
+	return strdup("en_GB.UTF-8");
+}
+
+char *vconf_keynode_get_name(keynode_t *keynode)
+{
+	return (char *)((struct node *)keynode)->name;
+}
+
+int vconf_keynode_get_int(const keynode_t *keynode)
+{
+	return ((struct node *)keynode)->i;
+}
+
+int vconf_keynode_get_bool(const keynode_t *keynode)
+{
+	return ((struct node *)keynode)->i;
+}
+
+char *vconf_keynode_get_str(const keynode_t *keynode)
+{
+	return ((struct node *)keynode)->s;
+}
+
+static void __change(const char *name, int i, char *s)
+{
+	struct node n = { name, i, s };
+
+	settings_update((keynode_t *)&n);
+}
+
+static void startup(void)
+{
+	settings_init();
+}
+
+static void cleanup(void)
+{
+	settings_exit();
+}
+
+/**
+ * @brief Positive test case of appcore_get_settings()
+ */
+static void utc_ApplicationFW_appcore_get_settings_func_01(void)
+{
+	int r = 0;
+	struct appcore_settings s;
+
+	r = appcore_get_settings(&s);
+	if (r || s.timeformat != APPCORE_TIME_FORMAT_12 ||
+	    s.rotation_lock != 1 || strcmp(s.lang, LANG_A) ||
+	    strcmp(s.region, "en_GB.UTF-8")) {
+		tet_infoline("appcore_get_settings() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Positive test case of appcore_get_settings(), a notification
+ * changes the snapshot without a backend read
+ */
+static void utc_ApplicationFW_appcore_get_settings_func_02(void)
+{
+	int r = 0;
+	struct appcore_settings s;
+
+	/* the rotation lock watch asked for by the first call */
+	while (g_main_context_iteration(NULL, FALSE))
+		;
+
+	__change(VCONFKEY_REGIONFORMAT_TIME1224, APPCORE_TIME_FORMAT_24, NULL);
+	__change(VCONFKEY_SETAPPL_ROTATE_LOCK_BOOL, 0, NULL);
+
+	r = appcore_get_settings(&s);
+	if (r || s.timeformat != APPCORE_TIME_FORMAT_24 ||
+	    s.rotation_lock != 0 || strcmp(s.lang, LANG_A)) {
+		tet_infoline("appcore_get_settings() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	tet_result(TET_PASS);
+}
+
+static int stop;
+
+static void *reader(void *data)
+{
+	struct appcore_settings s;
+	int i;
+	long torn = 0;
+
+	while (!__atomic_load_n(&stop, __ATOMIC_ACQUIRE)) {
+		appcore_get_settings(&s);
+		for (i = 1; s.lang[i]; i++) {
+			if (s.lang[i] != s.lang[0]) {
+				torn++;
+				break;
+			}
+		}
+	}
+
+	return (void *)torn;
+}
+
+/**
+ * @brief Positive test case of appcore_get_settings(), a reader never sees
+ * a half written snapshot
+ */
+static void utc_ApplicationFW_appcore_get_settings_func_03(void)
+{
+	pthread_t t;
+	void *torn = (void *)1;
+	int i;
+
+	stop = 0;
+	if (pthread_create(&t, NULL, reader, NULL)) {
+		tet_infoline("pthread_create() failed");
+		tet_result(TET_UNRESOLVED);
+		return;
+	}
+
+	for (i = 0; i < 100000; i++)
+		__change(VCONFKEY_LANGSET, 0, i % 2 ? LANG_A : LANG_B);
+
+	__atomic_store_n(&stop, 1, __ATOMIC_RELEASE);
+	pthread_join(t, &torn);
+
+	if (torn) {
+		tet_infoline("appcore_get_settings() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Negative test case of ug_init appcore_get_settings()
+ */
+static void utc_ApplicationFW_appcore_get_settings_func_04(void)
+{
+	int r = 0;
+
+	r = appcore_get_settings(NULL);
+	if (!r) {
+		tet_infoline("appcore_get_settings() failed in negative test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Positive test case of appcore_get_settings(), the rotation lock is
+ * watched only after the first call
+ */
+static void utc_ApplicationFW_appcore_get_settings_func_05(void)
+{
+	struct appcore_settings s;
+	int r1;
+	int r2;
+	int r3;
+
+	/* a watch asked for by the cases above */
+	while (g_main_context_iteration(NULL, FALSE))
+		;
+	settings_exit();
+	settings_init();
+
+	/* read from the backend until the main loop adds the watch */
+	v_lock = 0;
+	appcore_get_settings(&s);
+	r1 = s.rotation_lock == 0 && n_watch == 0;
+
+	while (g_main_context_iteration(NULL, FALSE))
+		;
+
+	/* the snapshot follows the notification only */
+	v_lock = 1;
+	appcore_get_settings(&s);
+	r2 = s.rotation_lock == 0 && n_watch == 1;
+
+	__change(VCONFKEY_SETAPPL_ROTATE_LOCK_BOOL, 1, NULL);
+	appcore_get_settings(&s);
+	r3 = s.rotation_lock == 1;
+
+	settings_exit();
+	settings_init();
+
+	if (!r1 || !r2 || !r3 || n_watch != 0) {
+		tet_infoline("appcore_get_settings() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
@@ -0,0 +1,262 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <tet_api.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locale.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <appcore-common.h>
+
+/*
+ * The message cache is built into the test with a catalog stand-in below.
+ * The libintl fallback reads the .mo files the test writes.
+ */
+#include "../../src/appcore-gettext.c"
+
+static void startup(void);
+static void cleanup(void);
+
+void (*tet_startup)(void) = startup;
+void (*tet_cleanup)(void) = cleanup;
+
+static void utc_ApplicationFW_appcore_gettext_lang_func_01(void);
+static void utc_ApplicationFW_appcore_gettext_lang_func_02(void);
+static void utc_ApplicationFW_appcore_gettext_lang_func_03(void);
+
+enum {
+	POSITIVE_TC_IDX = 0x01,
+	NEGATIVE_TC_IDX,
+};
+
+struct tet_testlist tet_testlist[] = {
+	{ utc_ApplicationFW_appcore_gettext_lang_func_01, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_gettext_lang_func_02, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_gettext_lang_func_03, POSITIVE_TC_IDX },
+	{ NULL, 0},
+};
+
+#define DOMAIN "Testcase"
+#define DOMAIN2 "Testcase2"
+#define MSGID "Testcase message"
+
+static char dir[] = "/tmp/appcore-gettext-XXXXXX";
+static const char *langs[] = { "lang1", "lang2" };
+static const char *domains[] = { DOMAIN, DOMAIN2 };
+
+/* the translation of the mapped catalog, NULL if none is mapped */
+static const char *c_str;
+
+void i18n_load(void)
+{
+}
+
+const char *catalog_find(const char *msgid)
+{
+	return c_str;
+}
+
+/* a catalog of one message without a hash table */
+static int __write(const char *lang, const char *domain)
+{
+	char path[PATH_MAX];
+	char tr[64];
+	unsigned int h[11];
+	FILE *fp;
+	int r;
+
+	snprintf(path, sizeof(path), "%s/%s", dir, lang);
+	mkdir(path, 0755);
+	strncat(path, "/LC_MESSAGES", sizeof(path) - strlen(path) - 1);
+	mkdir(path, 0755);
+	snprintf(path + strlen(path), sizeof(path) - strlen(path), "/%s.mo",
+		 domain);
+
+	snprintf(tr, sizeof(tr), "%s %s", domain, lang);
+
+	h[0] = 0x950412de;		/* magic */
+	h[1] = 0;			/* revision */
+	h[2] = 1;			/* strings */
+	h[3] = 28;			/* originals */
+	h[4] = 36;			/* translations */
+	h[5] = 0;			/* hash size */
+	h[6] = 44;			/* hash table */
+	h[7] = strlen(MSGID);
+	h[8] = 44;
+	h[9] = strlen(tr);
+	h[10] = 44 + sizeof(MSGID);
+
+	fp = fopen(path, "w");
+	if (fp == NULL)
+		return -1;
+
+	r = fwrite(h, 1, 28, fp) != 28 || fwrite(h + 7, 1, 16, fp) != 16 ||
+	    fwrite(MSGID, 1, sizeof(MSGID), fp) != sizeof(MSGID) ||
+	    fwrite(tr, 1, strlen(tr) + 1, fp) != strlen(tr) + 1;
+
+	return fclose(fp) || r ? -1 : 0;
+}
+
+/* libintl checks LANGUAGE again when the counter moves */
+extern int _nl_msg_cat_cntr;
+
+/* what update_lang() does for the message cache */
+static void __set_lang(const char *lang)
+{
+	setenv("LANGUAGE", lang, 1);
+	++_nl_msg_cat_cntr;
+	msgcache_invalidate();
+}
+
+static int __expect(const char *domain, const char *lang, const char *s)
+{
+	char tr[64];
+
+	snprintf(tr, sizeof(tr), "%s %s", domain, lang);
+
+	return s && !strcmp(s, tr);
+}
+
+static void startup(void)
+{
+	int i;
+	int j;
+
+	if (mkdtemp(dir) == NULL)
+		return;
+
+	for (i = 0; i < 2; i++) {
+		for (j = 0; j < 2; j++)
+			__write(langs[i], domains[j]);
+	}
+
+	/* LANGUAGE is not used in the C locale */
+	if (setlocale(LC_ALL, "C.UTF-8") == NULL)
+		setlocale(LC_ALL, "en_US.UTF-8");
+
+	bindtextdomain(DOMAIN, dir);
+	bindtextdomain(DOMAIN2, dir);
+	textdomain(DOMAIN);
+}
+
+static void cleanup(void)
+{
+	char path[PATH_MAX];
+	int i;
+	int j;
+
+	for (i = 0; i < 2; i++) {
+		for (j = 0; j < 2; j++) {
+			snprintf(path, sizeof(path), "%s/%s/LC_MESSAGES/%s.mo",
+				 dir, langs[i], domains[j]);
+			unlink(path);
+		}
+		snprintf(path, sizeof(path), "%s/%s/LC_MESSAGES", dir,
+			 langs[i]);
+		rmdir(path);
+		snprintf(path, sizeof(path), "%s/%s", dir, langs[i]);
+		rmdir(path);
+	}
+	rmdir(dir);
+
+	unsetenv("LANGUAGE");
+}
+
+/**
+ * @brief Positive test case of appcore_gettext() without a mapped catalog
+ */
+static void utc_ApplicationFW_appcore_gettext_lang_func_01(void)
+{
+	int r1;
+	int r2;
+
+	c_str = NULL;
+
+	__set_lang("lang1");
+	r1 = __expect(DOMAIN, "lang1", appcore_gettext(MSGID)) &&
+	     __expect(DOMAIN, "lang1", appcore_gettext(MSGID));
+
+	/* the remembered translation is not returned after the change */
+	__set_lang("lang2");
+	r2 = __expect(DOMAIN, "lang2", appcore_gettext(MSGID));
+
+	if (!r1 || !r2) {
+		tet_infoline("appcore_gettext() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Positive test case of appcore_dgettext() after a language change
+ */
+static void utc_ApplicationFW_appcore_gettext_lang_func_02(void)
+{
+	int r1;
+	int r2;
+
+	__set_lang("lang1");
+	r1 = __expect(DOMAIN2, "lang1", appcore_dgettext(DOMAIN2, MSGID)) &&
+	     __expect(DOMAIN2, "lang1", appcore_dgettext(DOMAIN2, MSGID));
+
+	__set_lang("lang2");
+	r2 = __expect(DOMAIN2, "lang2", appcore_dgettext(DOMAIN2, MSGID));
+
+	if (!r1 || !r2) {
+		tet_infoline("appcore_dgettext() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Positive test case of appcore_gettext() with a mapped catalog
+ */
+static void utc_ApplicationFW_appcore_gettext_lang_func_03(void)
+{
+	const char *tr1 = "mapped lang1";
+	const char *tr2 = "mapped lang2";
+	char *s1;
+	char *s2;
+	char *s3;
+
+	msgcache_flush();
+
+	/* remembered, the catalog is not asked again */
+	c_str = tr1;
+	s1 = appcore_gettext(MSGID);
+	c_str = tr2;
+	s2 = appcore_gettext(MSGID);
+
+	/* asked again after a language change */
+	msgcache_invalidate();
+	s3 = appcore_gettext(MSGID);
+
+	if (s1 != tr1 || s2 != tr1 || s3 != tr2 || nmsgs != 1) {
+		tet_infoline("appcore_gettext() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
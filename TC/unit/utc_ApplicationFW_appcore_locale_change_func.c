@@ -0,0 +1,241 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define _GNU_SOURCE
+
+#include <tet_api.h>
+#include <string.h>
+#include <pthread.h>
+#include <appcore-common.h>
+
+/*
+ * The i18n code is built into the test with a vconf stand-in below, to
+ * change the language and region settings without touching the device.
+ */
+#include "../../src/appcore-i18n.c"
+
+static void startup(void);
+static void cleanup(void);
+
+void (*tet_startup)(void) = startup;
+void (*tet_cleanup)(void) = cleanup;
+
+static void utc_ApplicationFW_appcore_locale_change_func_01(void);
+static void utc_ApplicationFW_appcore_locale_change_func_02(void);
+static void utc_ApplicationFW_appcore_locale_change_func_03(void);
+
+enum {
+	POSITIVE_TC_IDX = 0x01,
+	NEGATIVE_TC_IDX,
+};
+
+struct tet_testlist tet_testlist[] = {
+	{ utc_ApplicationFW_appcore_locale_change_func_01, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_locale_change_func_02, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_locale_change_func_03, POSITIVE_TC_IDX },
+	{ NULL, 0},
+};
+
+static const char *v_lang;
+static const char *v_region;
+
+char *vconf_get_str(const char *in_key)
+{
+	const char *v = NULL;
+
+	if (!strcmp(in_key, VCONFKEY_LANGSET))
+		v = v_lang;
+	else if (!strcmp(in_key, VCONFKEY_REGIONFORMAT))
+		v = v_region;
+
+	return v ? strdup(v) : NULL;
+}
+
+void catalog_set_domain(const char *domain, const char *dir)
+{
+}
+
+void catalog_set_lang(const char *lang)
+{
+}
+
+void msgcache_invalidate(void)
+{
+}
+
+int settings_get(struct appcore_settings *s)
+{
+	return -1;
+}
+
+static void startup(void)
+{
+	int i;
+
+	unsetenv("LC_ALL");
+	unsetenv("LANGUAGE");
+	for (i = 0; i < LC_NCAT; i++)
+		unsetenv(lc_cats[i].env);
+
+	v_lang = "C";
+	v_region = NULL;
+	appcore_set_i18n("Testcase", NULL);
+}
+
+static void cleanup(void)
+{
+}
+
+static void *worker(void *data)
+{
+	/* a thread which asks for the locale of appcore */
+	if (data)
+		uselocale(appcore_get_locale());
+
+	return (void *)nl_langinfo(CODESET);
+}
+
+static const char *__codeset(int own)
+{
+	pthread_t t;
+	void *ret = NULL;
+
+	if (pthread_create(&t, NULL, worker, (void *)(long)own) == 0)
+		pthread_join(t, &ret);
+
+	return ret ? : "";
+}
+
+/**
+ * @brief Positive test case of a language change, the main thread and
+ * appcore_get_locale() follow it, the global locale is not set again
+ */
+static void utc_ApplicationFW_appcore_locale_change_func_01(void)
+{
+	const char *s;
+
+	v_lang = "C.UTF-8";
+	update_lang();
+
+	s = setlocale(LC_MESSAGES, NULL);
+	if (strcmp(nl_langinfo(CODESET), "UTF-8") ||
+	    strcmp(__codeset(1), "UTF-8")) {
+		tet_infoline("language change failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	if (s == NULL || strcmp(s, "C") || !strcmp(__codeset(0), "UTF-8")) {
+		tet_infoline("global locale changed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/* en_US and tr_TR have the same codeset but not the same case mapping */
+#define REGION1 "en_US.UTF-8"
+#define REGION2 "tr_TR.UTF-8"
+/* en_GB has the collation of en_US but not its currency */
+#define REGION3 "en_GB.UTF-8"
+
+/* a copy of another locale under the name is not counted */
+static int __installed(const char *name, const char *currency)
+{
+	locale_t loc;
+	int r;
+
+	loc = newlocale(LC_ALL_MASK, name, (locale_t)0);
+	if (loc == (locale_t)0)
+		return 0;
+
+	r = !strcmp(nl_langinfo_l(INT_CURR_SYMBOL, loc), currency);
+	freelocale(loc);
+
+	return r;
+}
+
+/**
+ * @brief Positive test case of a region change to a locale of the same codeset
+ */
+static void utc_ApplicationFW_appcore_locale_change_func_02(void)
+{
+	const char *s;
+	int r;
+
+	if (!__installed(REGION1, "USD ") || !__installed(REGION2, "TRY ")) {
+		tet_infoline(REGION1 " or " REGION2 " is not installed");
+		tet_result(TET_UNRESOLVED);
+		return;
+	}
+
+	v_region = REGION1;
+	update_region();
+
+	v_region = REGION2;
+	update_region();
+
+	r = appcore_get_region_changes();
+	s = getenv("LC_CTYPE");
+	if ((r & (LC_CTYPE_MASK | LC_COLLATE_MASK)) !=
+	    (LC_CTYPE_MASK | LC_COLLATE_MASK) || s == NULL || strcmp(s, REGION2)) {
+		tet_infoline("appcore_get_region_changes() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	/* the same region again changes nothing */
+	update_region();
+	if (appcore_get_region_changes()) {
+		tet_infoline("appcore_get_region_changes() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Positive test case of a region change to a locale of the same
+ * collation
+ */
+static void utc_ApplicationFW_appcore_locale_change_func_03(void)
+{
+	int r;
+
+	if (!__installed(REGION1, "USD ") || !__installed(REGION3, "GBP ")) {
+		tet_infoline(REGION1 " or " REGION3 " is not installed");
+		tet_result(TET_UNRESOLVED);
+		return;
+	}
+
+	v_region = REGION1;
+	update_region();
+
+	v_region = REGION3;
+	update_region();
+
+	r = appcore_get_region_changes();
+	if ((r & LC_COLLATE_MASK) || !(r & LC_MONETARY_MASK)) {
+		tet_infoline("appcore_get_region_changes() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
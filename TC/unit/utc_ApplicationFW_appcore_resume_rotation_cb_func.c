@@ -0,0 +1,262 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <tet_api.h>
+#include <appcore-common.h>
+
+/*
+ * The rotation module is built into the test with a sensor, vconf and X
+ * stand-in below, to see which sensor calls a resume makes.
+ */
+#include "../../src/appcore-rotfilter.c"
+#include "../../src/appcore-rotation.c"
+
+static void startup(void);
+static void cleanup(void);
+
+void (*tet_startup)(void) = startup;
+void (*tet_cleanup)(void) = cleanup;
+
+static void utc_ApplicationFW_appcore_resume_rotation_cb_func_01(void);
+static void utc_ApplicationFW_appcore_resume_rotation_cb_func_02(void);
+static void utc_ApplicationFW_appcore_resume_rotation_cb_func_03(void);
+
+enum {
+	POSITIVE_TC_IDX = 0x01,
+	NEGATIVE_TC_IDX,
+};
+
+struct tet_testlist tet_testlist[] = {
+	{ utc_ApplicationFW_appcore_resume_rotation_cb_func_01, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_resume_rotation_cb_func_02, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_resume_rotation_cb_func_03, POSITIVE_TC_IDX },
+	{ NULL, 0},
+};
+
+static sensor_callback_func_t s_cb;
+static int s_checks;
+static int v_lock;
+
+int sf_connect(sensor_type_t sensor_type) { return 1; }
+int sf_disconnect(int handle) { return 0; }
+int sf_start(int handle, int option) { return 0; }
+int sf_stop(int handle) { return 0; }
+int sf_unregister_event(int handle, unsigned int event_type) { return 0; }
+
+int sf_register_event(int handle, unsigned int event_type,
+		      event_condition_t *event_condition,
+		      sensor_callback_func_t cb, void *cb_data)
+{
+	s_cb = cb;
+
+	return 0;
+}
+
+int sf_check_rotation(unsigned long *curr_state)
+{
+	s_checks++;
+	*curr_state = ROTATION_EVENT_0;
+
+	return 0;
+}
+
+/* the sensor reports the device turned */
+static void __event(int state)
+{
+	sensor_event_data_t ev;
+
+	ev.event_data_size = sizeof(state);
+	ev.event_data = &state;
+	s_cb(ACCELEROMETER_EVENT_ROTATION_CHECK, &ev, NULL);
+}
+
+int vconf_get_bool(const char *in_key, int *boolval)
+{
+	*boolval = v_lock;
+
+	return 0;
+}
+
+int vconf_notify_key_changed(const char *in_key, vconf_callback_fn cb,
+			     void *user_data)
+{
+	return 0;
+}
+
+int vconf_ignore_key_changed(const char *in_key, vconf_callback_fn cb)
+{
+	return 0;
+}
+
+int ecore_x_window_prop_card32_get(Ecore_X_Window win, Ecore_X_Atom atom,
+				   unsigned int *val, unsigned int len)
+{
+	return 0;
+}
+
+const struct x_ctx *appcore_x_get_ctx(void)
+{
+	return NULL;
+}
+
+static int n_rot;
+static enum appcore_rm last_rot;
+
+static int _rot_cb(enum appcore_rm m, void *data)
+{
+	n_rot++;
+	last_rot = m;
+
+	return 0;
+}
+
+/* no callback, sensor stand-in connected */
+static void __reset(void)
+{
+	appcore_rot_module.unset_cb();
+
+	free(rot.cbs);
+	memset(&rot, 0, sizeof(rot));
+
+	s_checks = 0;
+	n_rot = 0;
+	last_rot = APPCORE_RM_UNKNOWN;
+	v_lock = 0;
+}
+
+static void startup(void)
+{
+	ecore_init();
+}
+
+static void cleanup(void)
+{
+	__reset();
+
+	ecore_shutdown();
+}
+
+/**
+ * @brief Positive test case of appcore_resume_rotation_cb(), the mode
+ * reported while rotation was locked is delivered on resume without
+ * asking the sensor
+ */
+static void utc_ApplicationFW_appcore_resume_rotation_cb_func_01(void)
+{
+	int r = 0;
+
+	__reset();
+	v_lock = 1;
+	r = appcore_rot_module.set_cb(_rot_cb, NULL);
+	if (r) {
+		tet_infoline("set_cb() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	/* turned while locked, not delivered */
+	__event(ROTATION_EVENT_90);
+	appcore_rot_module.pause();
+
+	/* unlocked while paused */
+	v_lock = 0;
+	r = appcore_rot_module.resume();
+	if (r || n_rot != 1 || last_rot != APPCORE_RM_LANDSCAPE_NORMAL ||
+	    s_checks != 0) {
+		tet_infoline("appcore_resume_rotation_cb() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Positive test case of appcore_resume_rotation_cb(), the mode of
+ * before the pause is not taken as the current one until the first sensor
+ * event after the resume
+ */
+static void utc_ApplicationFW_appcore_resume_rotation_cb_func_02(void)
+{
+	int r = 0;
+	enum appcore_rm m;
+
+	__reset();
+	r = appcore_rot_module.set_cb(_rot_cb, NULL);
+	if (r) {
+		tet_infoline("set_cb() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	__event(ROTATION_EVENT_90);
+	appcore_rot_module.pause();
+
+	r = appcore_rot_module.resume();
+	if (r || n_rot != 1 || s_checks != 0) {
+		tet_infoline("appcore_resume_rotation_cb() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	/* turned while paused, the sensor is asked */
+	r = appcore_rot_module.get_state(&m);
+	if (r || m != APPCORE_RM_PORTRAIT_NORMAL || s_checks != 1) {
+		tet_infoline("a stale mode is returned after the resume in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	/* the event is delivered, then the mode is known again */
+	__event(ROTATION_EVENT_0);
+	r = appcore_rot_module.get_state(&m);
+	if (r || n_rot != 2 || last_rot != APPCORE_RM_PORTRAIT_NORMAL ||
+	    m != APPCORE_RM_PORTRAIT_NORMAL || s_checks != 1) {
+		tet_infoline("the sensor event after the resume is not delivered in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Positive test case of appcore_resume_rotation_cb(), no mode is
+ * delivered before the sensor ever reported one
+ */
+static void utc_ApplicationFW_appcore_resume_rotation_cb_func_03(void)
+{
+	int r = 0;
+
+	__reset();
+	r = appcore_rot_module.set_cb(_rot_cb, NULL);
+	if (r) {
+		tet_infoline("set_cb() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	appcore_rot_module.pause();
+	r = appcore_rot_module.resume();
+	if (r || n_rot != 0 || s_checks != 0) {
+		tet_infoline("appcore_resume_rotation_cb() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
@@ -0,0 +1,238 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <tet_api.h>
+#include <appcore-common.h>
+
+/* the filter has no dependency, build it into the test */
+#include "../../src/appcore-rotfilter.c"
+
+static void startup(void);
+static void cleanup(void);
+
+void (*tet_startup)(void) = startup;
+void (*tet_cleanup)(void) = cleanup;
+
+static void utc_ApplicationFW_appcore_rotation_filter_replay_func_01(void);
+static void utc_ApplicationFW_appcore_rotation_filter_replay_func_02(void);
+static void utc_ApplicationFW_appcore_rotation_filter_replay_func_03(void);
+static void utc_ApplicationFW_appcore_rotation_filter_replay_func_04(void);
+static void utc_ApplicationFW_appcore_rotation_filter_replay_func_05(void);
+
+enum {
+	POSITIVE_TC_IDX = 0x01,
+	NEGATIVE_TC_IDX,
+};
+
+struct tet_testlist tet_testlist[] = {
+	{ utc_ApplicationFW_appcore_rotation_filter_replay_func_01, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_rotation_filter_replay_func_02, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_rotation_filter_replay_func_03, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_rotation_filter_replay_func_04, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_rotation_filter_replay_func_05, POSITIVE_TC_IDX },
+	{ NULL, 0},
+};
+
+#define PN APPCORE_RM_PORTRAIT_NORMAL
+#define LN APPCORE_RM_LANDSCAPE_NORMAL
+
+#define COUNT(a) (sizeof(a) / sizeof(a[0]))
+
+struct sample {
+	unsigned int t;		/* msec */
+	enum appcore_rm m;
+};
+
+/* held near 45 degrees on a desk, then left in portrait */
+static const struct sample wobble[] = {
+	{ 0, LN }, { 90, PN }, { 210, LN }, { 330, PN }, { 410, LN },
+	{ 560, PN }, { 640, LN }, { 790, PN }, { 870, LN }, { 980, PN },
+};
+
+/* a single deliberate turn to landscape */
+static const struct sample turn[] = {
+	{ 0, LN },
+};
+
+/* turned to landscape with one bounce, turned back 2 seconds later */
+static const struct sample turn_back[] = {
+	{ 1000, LN }, { 1100, PN }, { 1180, LN }, { 3000, PN },
+};
+
+/* turned to landscape, tipped back towards portrait for a moment */
+static const struct sample tip_back[] = {
+	{ 0, LN }, { 400, PN }, { 800, LN },
+};
+
+static void startup(void)
+{
+}
+
+static void cleanup(void)
+{
+}
+
+/*
+ * Feed the samples as the rotation code does and fire the timer it would
+ * arm. Returns the number of delivered modes.
+ */
+static int __replay(const struct sample *in, int n, unsigned int dwell,
+		    unsigned int hysteresis, enum appcore_rm *out)
+{
+	int i;
+	int r;
+	int nout;
+	int armed;
+	unsigned int deadline;
+	enum appcore_rm m;
+	struct rot_filter f;
+
+	rot_filter_init(&f, dwell, hysteresis);
+	rot_filter_reset(&f, PN);
+
+	nout = 0;
+	armed = 0;
+	deadline = 0;
+	for (i = 0; i <= n; i++) {
+		if (armed && (i == n || deadline <= in[i].t)) {
+			m = rot_filter_expire(&f, deadline);
+			if (m != APPCORE_RM_UNKNOWN)
+				out[nout++] = m;
+			armed = 0;
+		}
+
+		if (i == n)
+			break;
+
+		r = rot_filter_feed(&f, in[i].m, in[i].t);
+		if (r == 0)
+			out[nout++] = in[i].m;
+
+		armed = r > 0;
+		if (armed)
+			deadline = in[i].t + r;
+	}
+
+	return nout;
+}
+
+static int __check(const enum appcore_rm *out, int nout,
+		   const enum appcore_rm *expected, int nexpected)
+{
+	int i;
+
+	if (nout != nexpected)
+		return -1;
+
+	for (i = 0; i < nout; i++) {
+		if (out[i] != expected[i])
+			return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Wobbling near 45 degrees is not delivered
+ */
+static void utc_ApplicationFW_appcore_rotation_filter_replay_func_01(void)
+{
+	int n;
+	enum appcore_rm out[COUNT(wobble)];
+
+	n = __replay(wobble, COUNT(wobble), 300, 200, out);
+	if (n != 0) {
+		tet_infoline("wobble is delivered");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief A deliberate turn is delivered once
+ */
+static void utc_ApplicationFW_appcore_rotation_filter_replay_func_02(void)
+{
+	int n;
+	enum appcore_rm out[COUNT(turn)];
+	enum appcore_rm expected[] = { LN };
+
+	n = __replay(turn, COUNT(turn), 300, 200, out);
+	if (__check(out, n, expected, COUNT(expected))) {
+		tet_infoline("turn is not delivered once");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief A bounce cancels the pending rotation, the turn back is delivered
+ */
+static void utc_ApplicationFW_appcore_rotation_filter_replay_func_03(void)
+{
+	int n;
+	enum appcore_rm out[COUNT(turn_back)];
+	enum appcore_rm expected[] = { LN, PN };
+
+	n = __replay(turn_back, COUNT(turn_back), 300, 200, out);
+	if (__check(out, n, expected, COUNT(expected))) {
+		tet_infoline("turn back is not delivered");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Going back to the previous mode needs the hysteresis time
+ */
+static void utc_ApplicationFW_appcore_rotation_filter_replay_func_04(void)
+{
+	int n;
+	enum appcore_rm out[COUNT(tip_back)];
+	enum appcore_rm expected[] = { LN };
+
+	n = __replay(tip_back, COUNT(tip_back), 300, 200, out);
+	if (__check(out, n, expected, COUNT(expected))) {
+		tet_infoline("tip back is delivered");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Without the filter every change is delivered
+ */
+static void utc_ApplicationFW_appcore_rotation_filter_replay_func_05(void)
+{
+	int n;
+	enum appcore_rm out[COUNT(wobble)];
+
+	n = __replay(wobble, COUNT(wobble), 0, 0, out);
+	if (n != COUNT(wobble)) {
+		tet_infoline("changes are filtered without the filter");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
@@ -0,0 +1,191 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define _GNU_SOURCE
+
+#include <tet_api.h>
+#include <string.h>
+#include <pthread.h>
+#include <appcore-common.h>
+
+/*
+ * The i18n code is built into the test with a vconf stand-in below. The
+ * test defers the text domain as appcore_init() does and runs the idler.
+ */
+#include "../../src/appcore-i18n.c"
+
+static void startup(void);
+static void cleanup(void);
+
+void (*tet_startup)(void) = startup;
+void (*tet_cleanup)(void) = cleanup;
+
+static void utc_ApplicationFW_appcore_set_lazy_i18n_func_01(void);
+static void utc_ApplicationFW_appcore_set_lazy_i18n_func_02(void);
+
+enum {
+	POSITIVE_TC_IDX = 0x01,
+	NEGATIVE_TC_IDX,
+};
+
+struct tet_testlist tet_testlist[] = {
+	{ utc_ApplicationFW_appcore_set_lazy_i18n_func_01, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_set_lazy_i18n_func_02, POSITIVE_TC_IDX },
+	{ NULL, 0},
+};
+
+static const char *v_lang;
+
+char *vconf_get_str(const char *in_key)
+{
+	if (strcmp(in_key, VCONFKEY_LANGSET) || v_lang == NULL)
+		return NULL;
+
+	return strdup(v_lang);
+}
+
+void catalog_set_domain(const char *domain, const char *dir)
+{
+}
+
+void catalog_set_lang(const char *lang)
+{
+}
+
+void msgcache_invalidate(void)
+{
+}
+
+int settings_get(struct appcore_settings *s)
+{
+	return -1;
+}
+
+static void startup(void)
+{
+	int i;
+
+	unsetenv("LC_ALL");
+	unsetenv("LANG");
+	unsetenv("LC_MESSAGES");
+	for (i = 0; i < LC_NCAT; i++)
+		unsetenv(lc_cats[i].env);
+	setlocale(LC_ALL, "C");
+}
+
+static void cleanup(void)
+{
+	appcore_set_lazy_i18n(0);
+}
+
+/* the codeset of the locale a worker thread gets */
+static void *worker(void *data)
+{
+	return (void *)nl_langinfo_l(CODESET, appcore_get_locale());
+}
+
+static const char *__worker_codeset(void)
+{
+	pthread_t t;
+	void *ret = NULL;
+
+	if (pthread_create(&t, NULL, worker, NULL) == 0)
+		pthread_join(t, &ret);
+
+	return ret;
+}
+
+/**
+ * @brief Positive test case of appcore_set_lazy_i18n()
+ */
+static void utc_ApplicationFW_appcore_set_lazy_i18n_func_01(void)
+{
+	int r = 0;
+	const char *s;
+
+	r = appcore_set_lazy_i18n(1);
+	if (r) {
+		tet_infoline("appcore_set_lazy_i18n() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	v_lang = "C.UTF-8";
+	r = set_i18n("Testcase", NULL);
+	if (r || !pending || cur_lang) {
+		tet_infoline("appcore_set_lazy_i18n() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	/* a worker does not load it, and gets the C locale */
+	s = __worker_codeset();
+	if (s == NULL || !strcmp(s, "UTF-8") || !pending || getenv("LANG")) {
+		tet_infoline("appcore_set_lazy_i18n() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	while (pending && g_main_context_iteration(NULL, FALSE))
+		;
+
+	/* the idler has applied it to the main thread */
+	s = nl_langinfo(CODESET);
+	if (pending || uselocale((locale_t)0) != cur_loc || strcmp(s, "UTF-8")) {
+		tet_infoline("appcore_set_lazy_i18n() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	s = __worker_codeset();
+	if (s == NULL || strcmp(s, "UTF-8")) {
+		tet_infoline("appcore_set_lazy_i18n() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Positive test case of appcore_set_lazy_i18n() with a lookup before the idle
+ */
+static void utc_ApplicationFW_appcore_set_lazy_i18n_func_02(void)
+{
+	int r = 0;
+
+	appcore_set_lazy_i18n(1);
+
+	v_lang = "C";
+	r = set_i18n("Testcase", NULL);
+	if (r || !pending) {
+		tet_infoline("appcore_set_lazy_i18n() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	/* the main thread loads it before it returns */
+	appcore_get_locale();
+	if (pending || pending_idler || cur_lang == NULL || strcmp(cur_lang, "C")) {
+		tet_infoline("appcore_set_lazy_i18n() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
@@ -0,0 +1,213 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <tet_api.h>
+#include <appcore-common.h>
+
+/* the scheduler has no dependency, build it into the test */
+#include "../../src/appcore-task.c"
+
+static void startup(void);
+static void cleanup(void);
+
+void (*tet_startup)(void) = startup;
+void (*tet_cleanup)(void) = cleanup;
+
+static void utc_ApplicationFW_appcore_task_graph_func_01(void);
+static void utc_ApplicationFW_appcore_task_graph_func_02(void);
+static void utc_ApplicationFW_appcore_task_graph_func_03(void);
+static void utc_ApplicationFW_appcore_task_graph_func_04(void);
+
+enum {
+	POSITIVE_TC_IDX = 0x01,
+	NEGATIVE_TC_IDX,
+};
+
+struct tet_testlist tet_testlist[] = {
+	{ utc_ApplicationFW_appcore_task_graph_func_01, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_task_graph_func_02, POSITIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_task_graph_func_03, NEGATIVE_TC_IDX },
+	{ utc_ApplicationFW_appcore_task_graph_func_04, NEGATIVE_TC_IDX },
+	{ NULL, 0},
+};
+
+/* order in which the tasks finished, by the first letter of the name */
+static char order[8];
+static int norder;
+static pthread_mutex_t order_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int __record(const char *name)
+{
+	usleep(1000);
+
+	pthread_mutex_lock(&order_lock);
+	order[norder++] = name[0];
+	pthread_mutex_unlock(&order_lock);
+
+	return 0;
+}
+
+static int __db(void *data) { return __record("db"); }
+static int __theme(void *data) { return __record("theme"); }
+static int __image(void *data) { return __record("image"); }
+static int __net(void *data) { return __record("net"); }
+static int __fail(void *data) { __record("fail"); return -1; }
+
+static const char * const image_deps[] = { "db", "theme", NULL };
+static const char * const theme_deps[] = { "db", NULL };
+static const char * const fail_deps[] = { "fail", NULL };
+static const char * const a_deps[] = { "b", NULL };
+static const char * const b_deps[] = { "a", NULL };
+
+static int __pos(char c)
+{
+	int i;
+
+	for (i = 0; i < norder; i++) {
+		if (order[i] == c)
+			return i;
+	}
+
+	return -1;
+}
+
+static void startup(void)
+{
+	norder = 0;
+	memset(order, 0, sizeof(order));
+}
+
+static void cleanup(void)
+{
+	task_exit();
+}
+
+/**
+ * @brief Positive test case of the startup tasks, dependencies run first
+ * and the tasks done before reset are done when task_wait() returns
+ */
+static void utc_ApplicationFW_appcore_task_graph_func_01(void)
+{
+	static const struct appcore_task tasks[] = {
+		{ "image", __image, image_deps, APPCORE_TASK_BEFORE_RESET },
+		{ "net", __net, NULL, APPCORE_TASK_AFTER_CREATE },
+		{ "theme", __theme, theme_deps, 0 },
+		{ "db", __db, NULL, 0 },
+		{ NULL, },
+	};
+	int r;
+
+	startup();
+	r = appcore_task_start("Testcase", tasks, NULL);
+	if (r) {
+		tet_infoline("appcore_task_start() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	appcore_task_release();
+	task_wait();
+
+	r = __pos('i') != -1 && __pos('d') < __pos('t') &&
+	    __pos('t') < __pos('i');
+	task_exit();
+
+	if (!r) {
+		tet_infoline("task order is wrong in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Positive test case of the startup tasks, a failed task skips the
+ * tasks depending on it
+ */
+static void utc_ApplicationFW_appcore_task_graph_func_02(void)
+{
+	static const struct appcore_task tasks[] = {
+		{ "fail", __fail, NULL, 0 },
+		{ "db", __db, fail_deps, APPCORE_TASK_BEFORE_RESET },
+		{ NULL, },
+	};
+	int r;
+
+	startup();
+	r = appcore_task_start("Testcase", tasks, NULL);
+	if (r) {
+		tet_infoline("appcore_task_start() failed in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+
+	task_wait();
+	r = __pos('f') == 0 && __pos('d') == -1;
+	task_exit();
+
+	if (!r) {
+		tet_infoline("failed task is not handled in positive test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Negative test case of the startup tasks, a cycle is refused
+ */
+static void utc_ApplicationFW_appcore_task_graph_func_03(void)
+{
+	static const struct appcore_task tasks[] = {
+		{ "a", __db, a_deps, 0 },
+		{ "b", __db, b_deps, 0 },
+		{ NULL, },
+	};
+	int r;
+
+	r = appcore_task_start("Testcase", tasks, NULL);
+	if (r != -1 || errno != EINVAL) {
+		tet_infoline("appcore_task_start() failed in negative test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
+
+/**
+ * @brief Negative test case of the startup tasks, an unknown dependency
+ * is refused
+ */
+static void utc_ApplicationFW_appcore_task_graph_func_04(void)
+{
+	static const struct appcore_task tasks[] = {
+		{ "theme", __theme, theme_deps, 0 },
+		{ NULL, },
+	};
+	int r;
+
+	r = appcore_task_start("Testcase", tasks, NULL);
+	if (r != -1 || errno != EINVAL) {
+		tet_infoline("appcore_task_start() failed in negative test case");
+		tet_result(TET_FAIL);
+		return;
+	}
+	tet_result(TET_PASS);
+}
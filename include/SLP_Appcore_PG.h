@@ -220,7 +220,7 @@ For more details, refer to GNU gettext manual (http://www.gnu.org/software/gette
  @{
 
 <h1 class="pg">Rotation</h3>
-An Application can display its UI in either landscape or portrait mode. The application registers to receive rotation events from the system with the appcore_set_rotation_cb() API. The system automatically calls the registered user's callback whenever the sensor framework detects that the current rotation status has changed. This continues until appcore_unset_rotation_cb() is called.
+An Application can display its UI in either landscape or portrait mode. The application registers to receive rotation events from the system with the appcore_set_rotation_cb() API. The system automatically calls the registered user's callback whenever the sensor framework detects that the current rotation status has changed. Several callbacks can be registered, for example by a toolkit and by the application, and they share one sensor connection. A callback is called until it is removed with appcore_remove_rotation_cb(), or until appcore_unset_rotation_cb() removes all of them.
 
 @code
 enum appcore_rm {
@@ -232,6 +232,7 @@ enum appcore_rm {
 };
 
 int appcore_set_rotation_cb(int (*cb)(enum appcore_rm, void *), void *data);
+int appcore_remove_rotation_cb(int (*cb)(enum appcore_rm, void *), void *data);
 int appcore_unset_rotation_cb(void);
 int appcore_get_rotation_state(enum appcore_rm *curr);
 @endcode
@@ -46,6 +46,7 @@
  */
 
 #include <libintl.h>
+#include <locale.h>
 #include <bundle.h>
 
 #ifdef __cplusplus
@@ -91,6 +92,25 @@ enum appcore_rm {
 				/**< Right handed landscape mode */
 };
 
+/**
+ * Rotation latency stages
+ * @see appcore_get_rotation_latency()
+ */
+enum appcore_rot_latency {
+	APPCORE_ROT_LATENCY_EVENT,
+			/**< Sensor event to rotation callback */
+	APPCORE_ROT_LATENCY_LOCK,
+			/**< Wait for the window manager rotation lock */
+	APPCORE_ROT_LATENCY_FRAME,
+			/**< Rotation callback to the first frame */
+	APPCORE_ROT_LATENCY_MAX,
+};
+
+/**
+ * Number of buckets in a rotation latency histogram
+ */
+#define APPCORE_ROT_LATENCY_BUCKETS 16
+
 /**
  * Time format
  * @see appcore_get_timeformat()
@@ -101,6 +121,56 @@ enum appcore_time_format {
 	APPCORE_TIME_FORMAT_24,
 };
 
+/**
+ * Length of the language and region strings in struct appcore_settings
+ */
+#define APPCORE_SETTINGS_STR_MAX 64
+
+/**
+ * System settings
+ * @see appcore_get_settings()
+ */
+struct appcore_settings {
+	enum appcore_time_format timeformat;
+			/**< Time format */
+	char lang[APPCORE_SETTINGS_STR_MAX];
+			/**< Language, such as en_US.UTF-8 */
+	char region[APPCORE_SETTINGS_STR_MAX];
+			/**< Region format */
+	int rotation_lock;
+			/**< 1 if the auto rotation is locked */
+	int low_memory;
+			/**< Value of VCONFKEY_SYSMAN_LOW_MEMORY */
+	int low_battery;
+			/**< Value of VCONFKEY_SYSMAN_BATTERY_STATUS_LOW */
+};
+
+/**
+ * Startup task flags
+ * @see struct appcore_task
+ */
+#define APPCORE_TASK_BEFORE_RESET 0x01
+			/**< Done before the first reset callback */
+#define APPCORE_TASK_AFTER_CREATE 0x02
+			/**< Started after the create callback returns */
+
+/**
+ * Startup task of the application
+ * @see struct appcore_ops
+ */
+struct appcore_task {
+	const char *name;
+		 /**< Unique name, NULL ends the array */
+	int (*func) (void *);
+		      /**< Called on a worker thread with the callback data of
+			appcore_ops, returns 0 on success */
+	const char * const *deps;
+			  /**< Names of the tasks done before, NULL ended, or NULL
+			    \n A task whose dependency failed is not called */
+	unsigned int flags;
+		       /**< APPCORE_TASK_BEFORE_RESET, APPCORE_TASK_AFTER_CREATE */
+};
+
 /**
  * Appcore operations which are called during the application life-cycle
  * @see appcore_efl_main()
@@ -120,7 +190,11 @@ struct appcore_ops {
 	int (*reset) (bundle *, void *);
 				/**< Called at the first idler
 				  and every relaunching */
-	void *reserved[6];
+	const struct appcore_task *tasks;
+		  /**< Startup tasks, run on worker threads from before the
+		    create callback. NULL if none. \n
+		    The tasks must not use EFL. */
+	void *reserved[5];
 		   /**< Reserved */
 	};
 
@@ -205,19 +279,21 @@ int appcore_set_event_callback(enum appcore_event event,
 
 /**
  * @par Description:
- * Set a rotation callback
+ * Add a rotation callback
  *
  * @par Purpose:
- * This function sets a callback function for rotation events. Callback function is invoked every time the rotation mode is changed.
+ * This function adds a callback function for rotation events. Callback function is invoked every time the rotation mode is changed.
  *
  * @par Typical use case:
  * To do something when the rotation mode is changed, use this API
  * 
  * @par Method of function operation:
- * Appcore receives rotation change from Sensor framework. When Appcore receive the change, it invokes the registered callback function.
+ * Appcore receives rotation change from Sensor framework. When Appcore receive the change, it invokes the registered callback functions in the order they were added.
+ * All callbacks share one sensor connection, which is opened when the first callback is added and closed when the last one is removed.
  * 
  * @par Important notes:
  * Locks the rotation mode, the registered callback is not invoked.
+ * A callback may add or remove callbacks while it is invoked. A callback added this way is invoked from the next change.
  *
  * @param[in] cb callback function
  * @param[in] data callback function data
@@ -226,11 +302,12 @@ int appcore_set_event_callback(enum appcore_event event,
  * 
  * @par Errors:
  * EINVAL - <I>cb</I> is NULL
- * EALREADY - rotation callback function already registered
+ * EALREADY - <I>cb</I> is already registered with the same <I>data</I>
+ * ENOSYS - the rotation module or the sensor framework could not be loaded
  *
- * @pre Callback is not set.
+ * @pre None.
  * @post None.
- * @see appcore_unset_rotation_cb(), appcore_get_rotation_state()
+ * @see appcore_remove_rotation_cb(), appcore_unset_rotation_cb(), appcore_get_rotation_state()
  * @remarks None.
  *
  * @par Sample code:
@@ -258,12 +335,55 @@ static int _rot_cb(enum appcore_rm, void *);
 int appcore_set_rotation_cb(int (*cb) (enum appcore_rm, void *),
 			    void *data);
 
+/**
+ * @par Description:
+ * Remove a rotation callback
+ *
+ * @par Purpose:
+ * This function removes a callback function added by appcore_set_rotation_cb(). The sensor is stopped when the last callback is removed.
+ *
+ * @param[in] cb callback function
+ * @param[in] data callback function data given to appcore_set_rotation_cb()
+ *
+ * @return 0 on success, -1 on error (<I>errno</I> set)
+ *
+ * @par Errors:
+ * ENOENT - <I>cb</I> is not registered with <I>data</I>
+ *
+ * @pre Callback is set by appcore_set_rotation_cb().
+ * @post None.
+ * @see appcore_set_rotation_cb(), appcore_unset_rotation_cb()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <appcore-common.h>
+
+...
+
+{
+	int r;
+
+	...
+
+	r = appcore_remove_rotation_cb(_rot_cb, data);
+	if (r == -1) {
+		// add exception handling
+	}
+	...
+}
+ * @endcode
+ *
+ */
+int appcore_remove_rotation_cb(int (*cb) (enum appcore_rm, void *),
+			       void *data);
+
 /**
  * @par Description:
  * Unset a rotation callback
  *
  * @par Purpose:
- * This function unsets a callback function for rotation events.
+ * This function unsets all callback functions for rotation events.
  *
  * @return 0 on success, -1 on error
  * 
@@ -303,6 +423,9 @@ int appcore_unset_rotation_cb(void);
  *
  * @par Method of function operation:
  * This function gets the current rotation mode from Sensor framework.
+ * While a rotation callback is set and the application is not paused,
+ * the mode kept from the rotation events is returned without asking
+ * Sensor framework.
  * 
  * @param[out] curr current rotation mode\n
  * If Sensor framework is not working, curr is set to APPCORE_RM_UNKNOWN.
@@ -311,6 +434,7 @@ int appcore_unset_rotation_cb(void);
  * 
  * @par Errors:
  * EINVAL - <I>curr</I> is NULL
+ * ENOSYS - the rotation module or the sensor framework could not be loaded
  *
  * @pre None.
  * @post None.
@@ -340,6 +464,169 @@ int appcore_unset_rotation_cb(void);
  */
 int appcore_get_rotation_state(enum appcore_rm *curr);
 
+/**
+ * @par Description:
+ * Set the stability filter for rotation events.
+ *
+ * @par Purpose:
+ * Holding the device near 45 degrees makes the sensor report the rotation
+ * back and forth. This function makes Appcore wait until a new rotation
+ * mode is stable before the rotation callback is invoked.
+ *
+ * @par Method of function operation:
+ * A new rotation mode is delivered only after the sensor has reported it
+ * for <I>dwell</I> milliseconds. Returning to the mode which was just left
+ * needs <I>hysteresis</I> milliseconds more. If the device goes back to the
+ * current mode during the wait, the pending rotation is cancelled.
+ *
+ * @par Corner cases/exceptions:
+ * If both <I>dwell</I> and <I>hysteresis</I> are 0, the filter is disabled
+ * and every rotation is delivered immediately. This is the default.
+ *
+ * @param[in] dwell time in milliseconds a new mode must be held (max 10000)
+ * @param[in] hysteresis extra time in milliseconds to return to the previous mode (max 10000)
+ *
+ * @return 0 on success, -1 on error (<I>errno</I> set)
+ *
+ * @par Errors:
+ * EINVAL - <I>dwell</I> or <I>hysteresis</I> is too large
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_set_rotation_cb()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <appcore-common.h>
+
+...
+
+{
+	int r;
+
+	r = appcore_set_rotation_filter(300, 200);
+	if (r == -1) {
+		// add exception handling
+	}
+	...
+}
+ * @endcode
+ *
+ */
+int appcore_set_rotation_filter(unsigned int dwell, unsigned int hysteresis);
+
+/**
+ * @par Description:
+ * Deliver rotation changes at the next frame.
+ *
+ * @par Purpose:
+ * A rotation callback invoked as soon as the sensor reports makes the
+ * application lay out in the middle of a frame. This function makes Appcore
+ * hold the change until the next animator tick, so that the new layout is
+ * done once, right before the frame is rendered.
+ *
+ * @par Method of function operation:
+ * The rotation is delivered from an Ecore animator. Changes reported before
+ * the tick are merged and only the last mode is delivered. If the window
+ * manager holds the rotation lock, the change is delivered at the first
+ * tick after the lock is released.
+ *
+ * @par Corner cases/exceptions:
+ * Disabled by default. Disabling it delivers a pending change at once.
+ *
+ * @param[in] enable 1 to deliver at the next frame, 0 to deliver at once
+ *
+ * @return 0 on success, -1 on error
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_set_rotation_cb(), appcore_set_rotation_filter()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <appcore-common.h>
+
+...
+
+{
+	appcore_set_rotation_frame_sync(1);
+	...
+}
+ * @endcode
+ *
+ */
+int appcore_set_rotation_frame_sync(int enable);
+
+/**
+ * @par Description:
+ * Get a rotation latency histogram.
+ *
+ * @par Purpose:
+ * To find out where a slow rotation spends its time, use this API.
+ *
+ * @par Method of function operation:
+ * Appcore stamps every sensor rotation event on arrival and records how
+ * long it takes until the rotation callbacks are invoked, how long the
+ * window manager holds the rotation lock, and how long it takes from the
+ * callbacks to the next rendered frame.
+ * Bucket 0 counts latencies under 1 msec, bucket <I>i</I> counts latencies
+ * from 2^(i-1) up to 2^i msec, and the last bucket counts all the longer ones.
+ *
+ * @par Corner cases/exceptions:
+ * The frame is taken to be rendered when the main loop goes idle after the
+ * callbacks.
+ *
+ * @param[in] type latency stage
+ * @param[out] hist buffer for the histogram
+ * @param[in] n number of entries in <I>hist</I>, up to #APPCORE_ROT_LATENCY_BUCKETS
+ *
+ * @return number of buckets copied on success, -1 on error (<I>errno</I> set)
+ *
+ * @par Errors:
+ * EINVAL - <I>type</I> is invalid, <I>hist</I> is NULL or <I>n</I> is not positive
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_reset_rotation_latency()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <appcore-common.h>
+
+...
+
+{
+	int i;
+	int r;
+	unsigned int hist[APPCORE_ROT_LATENCY_BUCKETS];
+
+	r = appcore_get_rotation_latency(APPCORE_ROT_LATENCY_EVENT, hist,
+					 APPCORE_ROT_LATENCY_BUCKETS);
+	if (r == -1) {
+		// add exception handling
+	}
+
+	for (i = 0; i < r; i++)
+		printf("< %u msec: %u\n", 1 << i, hist[i]);
+	...
+}
+ * @endcode
+ *
+ */
+int appcore_get_rotation_latency(enum appcore_rot_latency type,
+				 unsigned int *hist, int n);
+
+/**
+ * @par Description:
+ * Clear the rotation latency histograms.
+ *
+ * @see appcore_get_rotation_latency()
+ */
+void appcore_reset_rotation_latency(void);
+
 /**
  * @par Description:
  * Get the current time format.
@@ -348,7 +635,8 @@ int appcore_get_rotation_state(enum appcore_rm *curr);
  * To get the current time format, use this API.
  *
  * @par Method of function operation:
- * This function gets the current time format from vconf.
+ * This function gets the current time format from vconf. After appcore_init(),
+ * it is read from the settings snapshot, see appcore_get_settings().
  * 
  * @param[out] timeformat current time format\n
  * If vconf is not working, timeformat is set to APPCORE_TIME_FORMAT_UNKNOWN.
@@ -386,6 +674,115 @@ int appcore_get_rotation_state(enum appcore_rm *curr);
  */
 int appcore_get_timeformat(enum appcore_time_format *timeformat);
 
+/**
+ * @par Description:
+ * Get the system settings Appcore follows.
+ *
+ * @par Purpose:
+ * Reading a setting from the backend costs a request each time. This
+ * function returns the settings from memory instead, so it can be called
+ * whenever a label is drawn.
+ *
+ * @par Typical use case:
+ * Format a clock or a time stamp label.
+ *
+ * @par Method of function operation:
+ * After appcore_init(), Appcore keeps a snapshot of the time format,
+ * language, region, rotation lock and the low memory and low battery
+ * states, updated by the change notifications. The snapshot is copied
+ * without a lock, a copy made while it changes is made again. Before
+ * appcore_init(), the settings are read from the backend. The rotation
+ * lock is watched from the first call on; until the main loop has added
+ * its notification, it is read from the backend.
+ *
+ * @par Important notes:
+ * It can be called from any thread.
+ *
+ * @param[out] settings the settings
+ *
+ * @return 0 on success, -1 on error (<I>errno</I> set)
+ *
+ * @par Errors:
+ * EINVAL - <I>settings</I> is NULL
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_get_timeformat()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <appcore-common.h>
+
+...
+
+{
+	struct appcore_settings s;
+
+	appcore_get_settings(&s);
+	if (s.timeformat == APPCORE_TIME_FORMAT_24) {
+		...
+	}
+	...
+}
+ * @endcode
+ *
+ */
+int appcore_get_settings(struct appcore_settings *settings);
+
+/**
+ * @par Description:
+ * Get the locale categories changed by the last region change.
+ *
+ * @par Purpose:
+ * Not every region change event changes the locale categories. With this
+ * function, the callback of APPCORE_EVENT_REGION_CHANGE can skip the
+ * content which does not depend on the changed categories, such as a
+ * sorted list.
+ *
+ * @par Typical use case:
+ * Called in the callback of APPCORE_EVENT_REGION_CHANGE.
+ *
+ * @par Method of function operation:
+ * When the region changes, the data of every category, such as the
+ * collation tables, the decimal point and grouping, the currency and the
+ * date formats, is compared with the current one, and only the categories
+ * which differ are reported. A category another locale shares is not
+ * reported, as the collation of en_US and en_GB. The result is kept until
+ * the next region change.
+ *
+ * @return LC_*_MASK bits of the changed categories, 0 if none changed
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_set_event_callback()
+ * @remarks The time format setting also raises APPCORE_EVENT_REGION_CHANGE
+ * without a change of the categories.
+ *
+ * @par Sample code:
+ * @code
+#include <locale.h>
+#include <appcore-common.h>
+
+...
+
+static int __region_changed(void *data)
+{
+	int changed;
+
+	changed = appcore_get_region_changes();
+	if (changed & LC_COLLATE_MASK)
+		sort_list(data);
+	if (changed & (LC_TIME_MASK | LC_NUMERIC_MASK))
+		update_labels(data);
+
+	return 0;
+}
+ * @endcode
+ *
+ */
+int appcore_get_region_changes(void);
+
 /**
  * @par Description:
  * Set the information for the internationalization.
@@ -437,6 +834,321 @@ int appcore_get_timeformat(enum appcore_time_format *timeformat);
  */
 int appcore_set_i18n(const char *domainname, const char *dirname);
 
+/**
+ * @par Description:
+ * Defer the internationalization of appcore_init() off the launch path.
+ *
+ * @par Purpose:
+ * appcore_init() reads the language and region settings, sets the locale
+ * and binds the text domain before the create callback. Applications whose
+ * first frame has no translated text can leave this work for later.
+ *
+ * @par Typical use case:
+ * Called before appcore_efl_main() or appcore_service_main().
+ *
+ * @par Method of function operation:
+ * If enabled, appcore_init() only records the text domain. The locale is
+ * loaded when the main loop first becomes idle, or earlier by the first
+ * call of appcore_gettext(), appcore_dgettext() or appcore_get_locale()
+ * in the main thread, which load it before they return. A call of
+ * appcore_set_i18n() replaces the deferred domain.
+ *
+ * @par Important notes:
+ * gettext(), dgettext() and the locale dependent functions of the C
+ * library cannot load the locale. What they translate or format before
+ * the first idle uses the C locale and comes out untranslated: the labels
+ * of the first frame set through a _() macro on gettext(), the strings
+ * Elementary translates with dgettext() for the widgets built in the
+ * create callback, and the dates and numbers formatted for them. Until the
+ * first idle, translate with the Appcore functions above. Called from
+ * other threads before the first idle, they do not load it and return the
+ * message untranslated or a copy of the C locale.
+ *
+ * @param[in] enable 1 to defer, 0 to load in appcore_init()
+ *
+ * @return 0 on success
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_set_i18n(), appcore_gettext()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <appcore-efl.h>
+
+...
+
+int main(int argc, char *argv[])
+{
+	...
+	appcore_set_lazy_i18n(1);
+
+	return appcore_efl_main("i18n_example", &argc, &argv, &ops);
+}
+ * @endcode
+ *
+ */
+int appcore_set_lazy_i18n(int enable);
+
+/**
+ * @par Description:
+ * Get a locale for the calling thread.
+ *
+ * @par Purpose:
+ * When the language or region settings change, Appcore switches only the
+ * main thread, with uselocale(). The global locale is set once at launch
+ * and other threads keep it. This function gives a worker thread a locale
+ * object of its own which matches the current language and region.
+ *
+ * @par Typical use case:
+ * A worker thread formats numbers or dates with uselocale() or the *_l()
+ * functions.
+ *
+ * @par Method of function operation:
+ * The first call in a thread copies the current locale of Appcore. Later
+ * calls return the same object until the language or region changes, then
+ * a new copy is made. Only making the copy takes a lock.
+ *
+ * @par Important notes:
+ * The returned object belongs to the calling thread. Do not free it or
+ * pass it to another thread. It is valid until the next call of this
+ * function in the same thread. If the thread has set it with uselocale(),
+ * the new copy is set instead when the old one is released.
+ * setlocale(LC_ALL, NULL) keeps reporting the locale set at launch.
+ *
+ * @return locale object, LC_GLOBAL_LOCALE if no copy can be made
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_set_i18n()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <stdio.h>
+#include <appcore-common.h>
+
+...
+
+static void *worker(void *data)
+{
+	char buf[64];
+
+	...
+
+	uselocale(appcore_get_locale());
+	snprintf(buf, sizeof(buf), "%'.2f", value);
+	...
+}
+ * @endcode
+ *
+ */
+locale_t appcore_get_locale(void);
+
+/**
+ * @par Description:
+ * Get the translation of a message, remembering the result.
+ *
+ * @par Purpose:
+ * Applications translate the same labels again on every relayout or
+ * rotation. This function remembers the translations, so a label
+ * translated again costs a hash lookup.
+ *
+ * @par Typical use case:
+ * It is used in place of gettext(), for example in the _() macro.
+ *
+ * @par Method of function operation:
+ * Translations are kept in a hash table keyed by the message. A miss is
+ * looked up in the .mo catalog of the text domain for the current
+ * language, which is mapped read-only and looked up with its own hash
+ * table. If there is no catalog for the language, gettext() is called.
+ * The table is dropped when the language or the text domain changes, on
+ * low memory, by appcore_flush_memory() and when it holds too many
+ * messages.
+ *
+ * @par Important notes:
+ * Catalogs are expected in the codeset of the locale, no conversion is
+ * done. The returned string must not be modified or freed.
+ *
+ * @param[in] msgid the message to translate
+ *
+ * @return the translation, <I>msgid</I> if there is none, NULL on error (<I>errno</I> set)
+ *
+ * @par Errors:
+ * EINVAL - <I>msgid</I> is NULL
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_set_i18n(), appcore_dgettext()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <appcore-common.h>
+
+#define _(s) appcore_gettext(s)
+
+...
+
+static void __relayout(void *data)
+{
+	...
+	elm_object_text_set(label, _("Hello"));
+	...
+}
+ * @endcode
+ *
+ */
+char *appcore_gettext(const char *msgid);
+
+/**
+ * @par Description:
+ * Get the translation of a message in a given text domain, remembering the
+ * result.
+ *
+ * @par Purpose:
+ * Same as appcore_gettext() for messages of other text domains, such as
+ * the ones of a library.
+ *
+ * @par Typical use case:
+ * It is used in place of dgettext().
+ *
+ * @par Method of function operation:
+ * Translations are kept with the ones of appcore_gettext(), keyed by the
+ * domain and the message. A miss is looked up with dgettext().
+ *
+ * @par Important notes:
+ * The returned string must not be modified or freed.
+ *
+ * @param[in] domainname the text domain
+ * @param[in] msgid the message to translate
+ *
+ * @return the translation, <I>msgid</I> if there is none, NULL on error (<I>errno</I> set)
+ *
+ * @par Errors:
+ * EINVAL - <I>msgid</I> is NULL
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_gettext()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <appcore-common.h>
+
+...
+
+{
+	...
+	elm_object_text_set(button, appcore_dgettext("sys_string", "IDS_COM_SK_OK"));
+	...
+}
+ * @endcode
+ *
+ */
+char *appcore_dgettext(const char *domainname, const char *msgid);
+
+/**
+ * @par Description:
+ * Get the package name of the application.
+ *
+ * @par Purpose:
+ * Applications need the package name to build their own paths. This
+ * function returns the name Appcore has already resolved, without asking
+ * the AUL daemon again.
+ *
+ * @par Typical use case:
+ * Build the path of an application data file.
+ *
+ * @par Method of function operation:
+ * The name is resolved once and kept. It is taken from the path of the
+ * executable under /opt/apps or /usr/apps, which is given by the launcher
+ * in argv[0]. Otherwise the PKG_NAME environment variable set by the
+ * launcher is used, and AUL is asked only as a last resort.
+ *
+ * @par Important notes:
+ * The returned string must not be modified or freed.
+ *
+ * @return the package name, NULL on error (<I>errno</I> set)
+ *
+ * @par Errors:
+ * ENOENT - the package is not found
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_get_res_path()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <appcore-common.h>
+
+...
+
+{
+	const char *pkg;
+
+	pkg = appcore_get_pkgname();
+	if (pkg == NULL) {
+		// add exception handling
+	}
+	...
+}
+ * @endcode
+ *
+ */
+const char *appcore_get_pkgname(void);
+
+/**
+ * @par Description:
+ * Get the resource directory of the application.
+ *
+ * @par Purpose:
+ * This function returns the resource directory of the package, such as
+ * /opt/apps/<package>/res, without asking the AUL daemon or probing the
+ * file system again.
+ *
+ * @par Typical use case:
+ * Build the path of an image or an edje file of the application.
+ *
+ * @par Method of function operation:
+ * The directory is resolved once with the package name, see
+ * appcore_get_pkgname(). If the root of the package is not known from the
+ * executable path, /opt/apps is used if readable, /usr/apps otherwise.
+ *
+ * @par Important notes:
+ * The returned string must not be modified or freed.
+ *
+ * @return the resource directory, NULL on error (<I>errno</I> set)
+ *
+ * @par Errors:
+ * ENOENT - the package is not found
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_get_pkgname()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <stdio.h>
+#include <appcore-common.h>
+
+...
+
+{
+	char path[PATH_MAX];
+
+	snprintf(path, sizeof(path), "%s/edje/main.edj", appcore_get_res_path());
+	...
+}
+ * @endcode
+ *
+ */
+const char *appcore_get_res_path(void);
+
 /**
  * @par Description:
  * Set the measuring start time 
@@ -671,6 +1383,9 @@ int appcore_flush_memory(void);
  * Set a open callback
  * Only when application is running, if aul_open api is called, then this callback function is called. 
  * If your open_cb function return -1, then appcore doesn't raise window. 
+ * The window is raised asynchronously. If appcore does not know it yet, it
+ * is looked up when the main loop becomes idle, and a failure to find it
+ * is only logged.
  *
  * @param[in] cb callback function
  * @param[in] data callback function data
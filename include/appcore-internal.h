@@ -27,6 +27,7 @@
 #define LOG_TAG "Appcore"
 
 #include <stdio.h>
+#include <sys/types.h>
 #include <dlog.h>
 #include "appcore-common.h"
 
@@ -152,25 +153,152 @@ struct appcore {
 struct ui_ops {
 	void *data;
 	void (*cb_app) (enum app_event evnt, void *data, bundle *b);
+	unsigned int flags;
 };
 
+#define UI_NO_WINDOW	0x01	/* resume does not raise a window */
+
 /* appcore-i18n.c */
 extern void update_lang(void);
 extern int set_i18n(const char *domainname, const char *dirname);
+void i18n_load(void);
+void i18n_prewarm(void);
 void update_region(void);
 
 
-/* appcore-X.c */
-extern int x_raise_win(pid_t pid);
+/**
+ * Atoms interned once for every module
+ */
+enum x_atom {
+	X_ATOM_NET_WM_PID,
+	X_ATOM_NET_ACTIVE_WINDOW,
+	X_ATOM_NET_CLIENT_LIST,
+	X_ATOM_E_ROTATION_LOCK,
+	X_ATOM_E_PARENT_BORDER_WINDOW,
+	X_ATOM_MAX
+};
 
-/* appcore-util.c */
-/* extern void stack_trim(void);*/
+/**
+ * Appcore shared X context
+ */
+struct x_ctx {
+	struct _XDisplay *d;	/* ecore-x connection if any */
+	unsigned long root;
+	unsigned long atoms[X_ATOM_MAX];
+	int own;		/* connection opened by appcore */
+};
+
+/**
+ * X window module, libappcore-x
+ */
+struct appcore_x_ops {
+	int (*raise_win) (pid_t pid);
+	void (*exit) (void);
+};
+
+/**
+ * Rotation module, libappcore-rotation
+ */
+struct appcore_rot_ops {
+	int (*set_cb) (int (*cb) (enum appcore_rm, void *), void *data);
+	int (*remove_cb) (int (*cb) (enum appcore_rm, void *), void *data);
+	int (*unset_cb) (void);
+	int (*get_state) (enum appcore_rm *curr);
+	int (*pause) (void);
+	int (*resume) (void);
+	int (*set_filter) (unsigned int dwell, unsigned int hysteresis);
+	int (*set_frame_sync) (int enable);
+	int (*get_latency) (enum appcore_rot_latency type, unsigned int *hist,
+			    int n);
+	void (*reset_latency) (void);
+};
+
+#define APPCORE_X_MODULE "libappcore-x.so.1"
+#define APPCORE_X_MODULE_SYM "appcore_x_module"
+#define APPCORE_ROT_MODULE "libappcore-rotation.so.1"
+#define APPCORE_ROT_MODULE_SYM "appcore_rot_module"
+
+/* appcore-X.c, appcore-rotation.c */
+extern const struct appcore_x_ops appcore_x_module;
+extern const struct appcore_rot_ops appcore_rot_module;
 
+/* appcore-module.c */
+/*
+ * 0 if the window is raised or looked up from an idler, the failure of
+ * the lookup is then only in the log and ends the resume measurement
+ */
+extern int x_raise_win(pid_t pid);
+extern void x_exit(void);
 int appcore_pause_rotation_cb(void);
 int appcore_resume_rotation_cb(void);
 
+/* appcore-X.c */
+int appcore_x_add_win(unsigned int win);
+int appcore_x_del_win(unsigned int win);
+const struct x_ctx *appcore_x_get_ctx(void);
+void appcore_x_win_shown(unsigned int win);
+
+/* appcore-catalog.c */
+void catalog_set_domain(const char *domain, const char *dir);
+void catalog_set_lang(const char *lang);
+const char *catalog_find(const char *msgid);
+
+/* appcore-gettext.c */
+void msgcache_invalidate(void);
+void msgcache_flush(void);
+
+/* appcore-path.c */
+void path_init(int argc, char **argv);
+
+/* appcore-settings.c */
+struct _keynode_t;
+void settings_init(void);
+void settings_exit(void);
+void settings_update(struct _keynode_t *key);
+int settings_get(struct appcore_settings *s);
+
+/* appcore-startup.c */
+extern void appcore_startup_run(const char *name, int argc, char **argv);
+void startup_join(void);
+
+/* appcore-task.c */
+extern int appcore_task_start(const char *name,
+			      const struct appcore_task *tasks, void *data);
+extern void appcore_task_release(void);
+void task_wait(void);
+void task_exit(void);
+
+/* appcore-measure.c */
+void measure_resume_start(void);
+extern int appcore_measure_resume_time(void);
+extern void appcore_measure_hist_add(unsigned int *hist, int n,
+				     unsigned int msec);
+
+/**
+ * Rotation stability filter
+ */
+struct rot_filter {
+	unsigned int dwell;	/* msec a new mode must be held */
+	unsigned int hysteresis;	/* extra msec to return to prev */
+	enum appcore_rm stable;	/* last accepted mode */
+	enum appcore_rm prev;	/* mode before stable */
+	enum appcore_rm pending;	/* candidate mode */
+	unsigned int since;	/* when the candidate was first seen */
+};
+
+/* appcore-rotfilter.c */
+void rot_filter_init(struct rot_filter *f, unsigned int dwell,
+		     unsigned int hysteresis);
+void rot_filter_reset(struct rot_filter *f, enum appcore_rm m);
+int rot_filter_feed(struct rot_filter *f, enum appcore_rm m, unsigned int now);
+enum appcore_rm rot_filter_expire(struct rot_filter *f, unsigned int now);
+
+/* appcore-util.c */
+/* extern void stack_trim(void);*/
+
 
 #define ENV_START "APP_START_TIME"
+#define ENV_PKGNAME "PKG_NAME"
 
 #define MEMORY_FLUSH_ACTIVATE
 
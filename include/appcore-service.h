@@ -0,0 +1,145 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#ifndef __APPCORE_SERVICE_H__
+#define __APPCORE_SERVICE_H__
+
+/**
+ * @file    appcore-service.h
+ * @version 1.1
+ * @brief   This file contains APIs of the Appcore service library
+ */
+
+/**
+ * @addtogroup APPLICATION_FRAMEWORK
+ * @{
+ *
+ * @defgroup Appcore_Service Appcore service
+ * @version  1.1
+ * @brief    A base library for background services based on Appcore
+ *
+ */
+
+/**
+ * @addtogroup Appcore_Service
+ * @{
+ */
+
+#include <appcore-common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @par Description:
+ * This is a main function for a background service without windows. \n
+ * Refer to programming guide for the details.
+ *
+ * @par Purpose:
+ * To develop a service that follows the Appcore life cycle without
+ * initializing EFL or connecting to the X server.
+ *
+ * @par Method of function operation:
+ * Initialize internationalization and notifications for receiving system
+ * events such as low memory, low battery, language change, etc.\n
+ * And, start a glib mainloop.
+ * A resume request invokes resume() instead of raising a window.
+ * On low memory, memory is flushed as for an application in the background.
+ *
+ * @param[in] name Service name
+ * @param[in] argc A count of the arguments
+ * @param[in] argv An array of pointers to the strings which are those arguments
+ * @param[in] ops Appcore operations, pause() is never invoked
+ *
+ * @return 0 on success, -1 on error (<I>errno</I> set)
+ *
+ * @par Errors:
+ * EINPROGRESS - mainloop already started \n
+ * EINVAL - one of parameters is NULL \n
+ * ECANCELED - create() callback returns error (none zero value) \n
+ *
+ * @par Corner cases/exceptions:
+ * If <I>ops</I> has no callback function, this function just starts a mainloop.
+ *
+ * @pre None.
+ * @post None.
+ * @see appcore_service_exit()
+ * @remarks None.
+ *
+ * @par Sample code:
+ * @code
+#include <appcore-service.h>
+
+static int _create(void *);
+static int _reset(bundle *, void *);
+
+int main(int argc, char *argv[])
+{
+	int r;
+	struct appcore_ops ops = {
+		.create = _create,
+		.reset = _reset,
+		...
+	};
+
+	...
+
+	r = appcore_service_main("myservice", &argc, &argv, &ops);
+	if (r) {
+		// add exception handling
+		perror("Appcore service main");
+	}
+}
+ * @endcode
+ *
+ */
+int appcore_service_main(const char *name, int *argc, char ***argv,
+			 struct appcore_ops *ops);
+
+/**
+ * @par Description:
+ * Quit the mainloop started by appcore_service_main().
+ *
+ * @par Purpose:
+ * To stop a service from inside, for example when it has no work left.
+ * appcore_service_main() returns after terminate() is invoked.
+ *
+ * @pre appcore_service_main() is running.
+ * @post None.
+ * @see appcore_service_main()
+ * @remarks None.
+ *
+ */
+void appcore_service_exit(void);
+
+#ifdef __cplusplus
+}
+#endif
+/**
+ * @}
+ */
+/**
+ * @}
+ */
+#endif				/* __APPCORE_SERVICE_H__ */
@@ -12,6 +12,8 @@ BuildRequires:  pkgconfig(aul)
 BuildRequires:  pkgconfig(rua)
 BuildRequires:  pkgconfig(dlog)
 BuildRequires:  pkgconfig(x11)
+BuildRequires:  pkgconfig(x11-xcb)
+BuildRequires:  pkgconfig(xcb)
 BuildRequires:  pkgconfig(sysman)
 BuildRequires:  pkgconfig(elementary)
 BuildRequires:  pkgconfig(ecore)
@@ -45,6 +47,24 @@ Requires:   %{name}-common-devel = %{version}-%{release}
 %description efl-devel
 Application basic EFL (devel)
 
+%package service
+Summary:    App basic service
+Group:      Development/Libraries
+Requires(post): /sbin/ldconfig
+Requires(postun): /sbin/ldconfig
+
+%description service
+Application basic for background services
+
+%package service-devel
+Summary:    App basic service (devel)
+Group:      Development/Libraries
+Requires:   %{name}-service = %{version}-%{release}
+Requires:   %{name}-common-devel = %{version}-%{release}
+
+%description service-devel
+Application basic for background services (devel)
+
 %package common
 Summary:    App basics common
 Group:      Development/Libraries
@@ -58,7 +78,6 @@ Application basics common
 Summary:    App basics common (devel)
 Group:      Development/Libraries
 Requires:   %{name}-common = %{version}-%{release}
-Requires:   pkgconfig(sensor)
 Requires:   pkgconfig(vconf)
 Requires:   pkgconfig(elementary)
 Requires:   pkgconfig(aul)
@@ -92,6 +111,10 @@ rm -rf %{buildroot}
 
 %postun efl -p /sbin/ldconfig
 
+%post service -p /sbin/ldconfig
+
+%postun service -p /sbin/ldconfig
+
 %post common -p /sbin/ldconfig
 
 %postun common -p /sbin/ldconfig
@@ -110,13 +133,27 @@ rm -rf %{buildroot}
 %{_libdir}/libappcore-efl.so
 %{_libdir}/pkgconfig/appcore-efl.pc
 
+%files service
+%defattr(-,root,root,-)
+%{_libdir}/libappcore-service.so.*
+
+%files service-devel
+%defattr(-,root,root,-)
+%{_includedir}/appcore/appcore-service.h
+%{_libdir}/libappcore-service.so
+%{_libdir}/pkgconfig/appcore-service.pc
+
 %files common
 %defattr(-,root,root,-)
 %{_libdir}/libappcore-common.so.*
+%{_libdir}/libappcore-x.so.*
+%{_libdir}/libappcore-rotation.so.*
 
 %files common-devel
 %defattr(-,root,root,-)
 %{_libdir}/libappcore-common.so
+%{_libdir}/libappcore-x.so
+%{_libdir}/libappcore-rotation.so
 %{_libdir}/pkgconfig/appcore-common.pc
 %{_includedir}/appcore/appcore-common.h
 %{_includedir}/SLP_Appcore_PG.h
@@ -25,116 +25,255 @@
 #include <string.h>
 #include <errno.h>
 #include <signal.h>
+#include <unistd.h>
 
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
+#include <Ecore_X.h>
+#include <glib.h>
 
 #include "appcore-internal.h"
 
-static Atom a_pid;
-static Atom a_active_win;
+#define WIN_MAX 16
+#define CLIENT_MAX 1024
 
-static pid_t __get_win_pid(Display *d, Window win)
-{
-	int r;
-	pid_t pid;
+static struct x_ctx ctx;
 
-	Atom a_type;
-	int format;
-	unsigned long nitems;
-	unsigned long bytes_after;
-	unsigned char *prop_ret;
-	XWindowAttributes attr;
+static char *atom_names[X_ATOM_MAX] = {
+	[X_ATOM_NET_WM_PID] = "_NET_WM_PID",
+	[X_ATOM_NET_ACTIVE_WINDOW] = "_NET_ACTIVE_WINDOW",
+	[X_ATOM_NET_CLIENT_LIST] = "_NET_CLIENT_LIST",
+	[X_ATOM_E_ROTATION_LOCK] = "_E_ROTATION_LOCK",
+	[X_ATOM_E_PARENT_BORDER_WINDOW] = "_E_PARENT_BORDER_WINDOW",
+};
 
-	_retv_if(d == NULL || !a_pid, -1);
-
-	if (!XGetWindowAttributes(d, win, &attr))
-		return -1;
+/* pending raise request */
+struct raise_s {
+	pid_t pid;
+	Window win;		/* raised, waiting to come on top */
+	guint idler;		/* deferred lookup */
+};
+static struct raise_s rs;
 
-	if (attr.override_redirect || attr.class == InputOnly)
-		return -1;
+/* top-level windows of this process, most recently shown at the end */
+static Window wins[WIN_MAX];
+static int nwins;
 
-	prop_ret = NULL;
-	r = XGetWindowProperty(d, win, a_pid, 0, 1, False, XA_CARDINAL,
-			       &a_type, &format, &nitems, &bytes_after,
-			       &prop_ret);
-	if (r != Success || prop_ret == NULL)
-		return -1;
+static int __find_client(Display *d, Window *win, pid_t pid)
+{
+	int i;
+	int n;
+	int found;
+	xcb_connection_t *c;
+	xcb_window_t *clients;
+	xcb_get_property_reply_t *rep;
+	xcb_get_property_reply_t *prep;
+	xcb_get_property_cookie_t *cookies;
+
+	c = XGetXCBConnection(d);
+	_retv_if(c == NULL, 0);
+
+	rep = xcb_get_property_reply(c,
+			xcb_get_property(c, 0, ctx.root,
+					 ctx.atoms[X_ATOM_NET_CLIENT_LIST],
+					 XCB_ATOM_WINDOW, 0, CLIENT_MAX),
+			NULL);
+	_retv_if(rep == NULL, 0);
+
+	n = xcb_get_property_value_length(rep) / sizeof(xcb_window_t);
+	clients = xcb_get_property_value(rep);
+
+	cookies = malloc(n * sizeof(xcb_get_property_cookie_t));
+	if (cookies == NULL) {
+		free(rep);
+		return 0;
+	}
 
-	if (a_type == XA_CARDINAL && format == 32)
-		pid = *(unsigned long *)prop_ret;
-	else
-		pid = -1;
+	/* send every request first, then collect the replies */
+	for (i = 0; i < n; i++) {
+		cookies[i] = xcb_get_property(c, 0, clients[i],
+					      ctx.atoms[X_ATOM_NET_WM_PID],
+					      XCB_ATOM_CARDINAL, 0, 1);
+	}
 
-	XFree(prop_ret);
+	found = 0;
+	for (i = 0; i < n; i++) {
+		if (found) {
+			xcb_discard_reply(c, cookies[i].sequence);
+			continue;
+		}
 
-	return pid;
-}
+		prep = xcb_get_property_reply(c, cookies[i], NULL);
+		if (prep == NULL)
+			continue;
 
-static int __find_win(Display *d, Window *win, pid_t pid)
-{
-	int r;
-	pid_t p;
-	unsigned int n;
-	Window root, parent, *child;
-
-	p = __get_win_pid(d, *win);
-	if (p == pid)
-		return 1;
-
-	r = XQueryTree(d, *win, &root, &parent, &child, &n);
-	if (r) {
-		int i;
-		int found = 0;
-
-		for (i = 0; i < n; i++) {
-			found = __find_win(d, &child[i], pid);
-			if (found) {
-				*win = child[i];
-				break;
-			}
+		if (prep->type == XCB_ATOM_CARDINAL && prep->format == 32
+		    && xcb_get_property_value_length(prep) >= 4
+		    && *(uint32_t *)xcb_get_property_value(prep) == pid) {
+			*win = clients[i];
+			found = 1;
 		}
-		XFree(child);
-
-		if (found)
-			return 1;
+		free(prep);
 	}
 
-	return 0;
+	free(cookies);
+	free(rep);
+
+	return found;
 }
 
 static int __raise_win(Display *d, Window win)
 {
 	XEvent xev;
-	Window root;
-
-	if (!a_active_win)
-		a_active_win = XInternAtom(d, "_NET_ACTIVE_WINDOW", False);
-
-	root = XDefaultRootWindow(d);
 
 	xev.xclient.type = ClientMessage;
 	xev.xclient.display = d;
 	xev.xclient.window = win;
-	xev.xclient.message_type = a_active_win;
+	xev.xclient.message_type = ctx.atoms[X_ATOM_NET_ACTIVE_WINDOW];
 	xev.xclient.format = 32;
 	xev.xclient.data.l[0] = 1;
 	xev.xclient.data.l[1] = CurrentTime;
 	xev.xclient.data.l[2] = 0;
 	xev.xclient.data.l[3] = 0;
 	xev.xclient.data.l[4] = 0;
-	XSendEvent(d, root, False,
+	XSendEvent(d, ctx.root, False,
 		   SubstructureRedirectMask | SubstructureNotifyMask, &xev);
 
 	return 0;
 }
 
-int x_raise_win(pid_t pid)
+EXPORT_API const struct x_ctx *appcore_x_get_ctx(void)
+{
+	Status r;
+	Display *d;
+
+	if (ctx.d)
+		return &ctx;
+
+	/* share the connection of ecore-x if the toolkit has one */
+	d = ecore_x_display_get();
+	if (d == NULL) {
+		d = XOpenDisplay(NULL);
+		_retvm_if(d == NULL, NULL, "XOpenDisplay failed");
+		ctx.own = 1;
+	}
+
+	/* one round trip for all of them */
+	r = XInternAtoms(d, atom_names, X_ATOM_MAX, False, ctx.atoms);
+	if (!r) {
+		_ERR("XInternAtoms failed");
+		if (ctx.own)
+			XCloseDisplay(d);
+		memset(&ctx, 0, sizeof(struct x_ctx));
+		return NULL;
+	}
+
+	ctx.d = d;
+	ctx.root = XDefaultRootWindow(d);
+
+	return &ctx;
+}
+
+static int __find_own_win(Window *win)
+{
+	_retv_if(nwins < 1, 0);
+
+	*win = wins[nwins - 1];
+
+	return 1;
+}
+
+static void __remove_own_win(Window win)
+{
+	int i;
+
+	for (i = 0; i < nwins; i++) {
+		if (wins[i] == win) {
+			memmove(&wins[i], &wins[i + 1],
+				(nwins - i - 1) * sizeof(Window));
+			nwins--;
+			return;
+		}
+	}
+}
+
+EXPORT_API int appcore_x_add_win(unsigned int win)
+{
+	_retv_if(win == 0, -1);
+
+	__remove_own_win(win);
+
+	if (nwins == WIN_MAX) {
+		memmove(&wins[0], &wins[1], (WIN_MAX - 1) * sizeof(Window));
+		nwins--;
+	}
+	wins[nwins++] = win;
+
+	return 0;
+}
+
+EXPORT_API int appcore_x_del_win(unsigned int win)
 {
+	__remove_own_win(win);
+
+	return 0;
+}
+
+/* x_raise_win() has returned, the LAUNCH log tells the failure */
+static void __raise_failed(pid_t pid)
+{
+	int msec;
+
+	_ERR("no window for pid %d", pid);
+
+	memset(&rs, 0, sizeof(struct raise_s));
+
+	msec = appcore_measure_resume_time();
+	LOG(LOG_DEBUG, "LAUNCH", "[%d:Application:resume:failed] %d msec",
+	    pid, msec);
+}
+
+static gboolean __raise_idle(gpointer data)
+{
+	int found;
+	Window win = None;
+
+	rs.idler = 0;
+
+	found = __find_client(ctx.d, &win, rs.pid);
+	if (!found) {
+		__raise_failed(rs.pid);
+		return FALSE;
+	}
+
+	__raise_win(ctx.d, win);
+	XFlush(ctx.d);
 
+	rs.win = win;
+
+	return FALSE;
+}
+
+EXPORT_API void appcore_x_win_shown(unsigned int win)
+{
+	int msec;
+
+	_ret_if(rs.win == 0 || rs.win != win);
+
+	rs.win = 0;
+
+	msec = appcore_measure_resume_time();
+	if (msec)
+		LOG(LOG_DEBUG, "LAUNCH", "[%d:Application:resume:raised] %d msec",
+		    getpid(), msec);
+}
+
+static int __x_raise_win(pid_t pid)
+{
 	int r;
 	int found;
-	Display *d;
 	Window win;
 
 	if (pid < 1) {
@@ -148,24 +287,45 @@ int x_raise_win(pid_t pid)
 		return -1;
 	}
 
-	d = XOpenDisplay(NULL);
-	_retv_if(d == NULL, -1);
+	_retv_if(appcore_x_get_ctx() == NULL, -1);
 
-	win = XDefaultRootWindow(d);
-
-	if (!a_pid)
-		a_pid = XInternAtom(d, "_NET_WM_PID", True);
+	if (pid == getpid())
+		found = __find_own_win(&win);
+	else
+		found = 0;
 
-	found = __find_win(d, &win, pid);
 	if (!found) {
-		XCloseDisplay(d);
-		errno = ENOENT;
-		return -1;
+		/* the lookup needs round trips, do it after returning */
+		rs.pid = pid;
+		if (rs.idler == 0)
+			rs.idler = g_idle_add(__raise_idle, NULL);
+		return 0;
 	}
 
-	r = __raise_win(d, win);
+	r = __raise_win(ctx.d, win);
 
-	XCloseDisplay(d);
+	XFlush(ctx.d);
+
+	rs.win = win;
 
 	return r;
 }
+
+static void __x_exit(void)
+{
+	nwins = 0;
+
+	if (rs.idler)
+		g_source_remove(rs.idler);
+	memset(&rs, 0, sizeof(struct raise_s));
+
+	if (ctx.own)
+		XCloseDisplay(ctx.d);
+
+	memset(&ctx, 0, sizeof(struct x_ctx));
+}
+
+EXPORT_API const struct appcore_x_ops appcore_x_module = {
+	.raise_win = __x_raise_win,
+	.exit = __x_exit,
+};
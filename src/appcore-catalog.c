@@ -0,0 +1,353 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "appcore-internal.h"
+
+/*
+ * Message catalogs of the text domain, mapped read-only. The .mo file is
+ * looked up with its own hash table, without the domain and locale
+ * resolution gettext() does on every call.
+ */
+
+#define MO_MAGIC 0x950412de
+#define MO_MAGIC_SWAPPED 0xde120495
+
+struct mo_header {
+	unsigned int magic;
+	unsigned int revision;
+	unsigned int nstrings;
+	unsigned int orig_off;
+	unsigned int trans_off;
+	unsigned int hash_size;
+	unsigned int hash_off;
+};
+
+struct mo_str {
+	unsigned int len;
+	unsigned int off;
+};
+
+struct catalog {
+	char *domain;
+	char *lang;
+
+	const char *map;	/* NULL if there is no catalog */
+	size_t size;
+	int swap;
+
+	unsigned int nstrings;
+	const struct mo_str *orig;
+	const struct mo_str *trans;
+	unsigned int hash_size;
+	const unsigned int *hash;
+
+	struct catalog *next;
+};
+
+static char *cat_domain;
+static char *cat_dir;
+static char *cat_lang;
+
+/* never unmapped, returned strings stay valid as with gettext() */
+static struct catalog *catalogs;
+static struct catalog *cur;
+
+static inline unsigned int __w(const struct catalog *c, unsigned int v)
+{
+	return c->swap ? __builtin_bswap32(v) : v;
+}
+
+/* same hash as GNU gettext uses to build the table */
+static unsigned int __hash(const char *s)
+{
+	unsigned int h = 0;
+	unsigned int g;
+
+	while (*s) {
+		h = (h << 4) + (unsigned char)*s++;
+		g = h & 0xf0000000;
+		if (g) {
+			h ^= g >> 24;
+			h ^= g;
+		}
+	}
+
+	return h;
+}
+
+static const char *__str(const struct catalog *c, const struct mo_str *s)
+{
+	unsigned int len;
+	unsigned int off;
+
+	len = __w(c, s->len);
+	off = __w(c, s->off);
+	if (off >= c->size || len >= c->size - off || c->map[off + len])
+		return NULL;
+
+	return c->map + off;
+}
+
+static int __map(struct catalog *c, const char *path)
+{
+	int fd;
+	struct stat st;
+	void *map;
+	const struct mo_header *h;
+	unsigned int n;
+	unsigned int orig_off;
+	unsigned int trans_off;
+	unsigned int hash_off;
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return -1;
+
+	if (fstat(fd, &st) == -1 ||
+	    st.st_size < (off_t)sizeof(struct mo_header)) {
+		close(fd);
+		return -1;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	_retvm_if(map == MAP_FAILED, -1, "mmap %s error", path);
+
+	c->map = map;
+	c->size = st.st_size;
+
+	h = map;
+	if (h->magic == MO_MAGIC_SWAPPED)
+		c->swap = 1;
+	else if (h->magic != MO_MAGIC)
+		goto err;
+
+	n = __w(c, h->nstrings);
+	orig_off = __w(c, h->orig_off);
+	trans_off = __w(c, h->trans_off);
+	if (n > c->size / sizeof(struct mo_str) ||
+	    orig_off > c->size - n * sizeof(struct mo_str) ||
+	    trans_off > c->size - n * sizeof(struct mo_str) ||
+	    orig_off % 4 || trans_off % 4)
+		goto err;
+
+	c->nstrings = n;
+	c->orig = (const struct mo_str *)(c->map + orig_off);
+	c->trans = (const struct mo_str *)(c->map + trans_off);
+
+	/* without a table the sorted originals are searched */
+	n = __w(c, h->hash_size);
+	hash_off = __w(c, h->hash_off);
+	if (n > 2 && n <= c->size / sizeof(unsigned int) &&
+	    hash_off <= c->size - n * sizeof(unsigned int) && !(hash_off % 4)) {
+		c->hash_size = n;
+		c->hash = (const unsigned int *)(c->map + hash_off);
+	}
+
+	_DBG("[APP %d] catalog %s: %u strings", getpid(), path, c->nstrings);
+
+	return 0;
+
+ err:
+	_ERR("%s: not a message catalog", path);
+	munmap(map, c->size);
+	c->map = NULL;
+	c->size = 0;
+	c->swap = 0;
+
+	return -1;
+}
+
+/* ko_KR.UTF-8 is found as ko_KR.UTF-8, ko_KR or ko like gettext does */
+static void __load(struct catalog *c, const char *dir)
+{
+	char path[PATH_MAX];
+	char name[NAME_MAX];
+	char *p;
+
+	snprintf(name, sizeof(name), "%s", c->lang);
+
+	while (1) {
+		snprintf(path, sizeof(path), "%s/%s/LC_MESSAGES/%s.mo",
+			 dir, name, c->domain);
+		if (__map(c, path) == 0)
+			return;
+
+		p = strchr(name, '.');
+		if (p == NULL)
+			p = strchr(name, '_');
+		if (p == NULL)
+			break;
+		*p = '\0';
+	}
+
+	_DBG("[APP %d] no catalog of %s for %s", getpid(), c->domain, c->lang);
+}
+
+static void __switch(void)
+{
+	struct catalog *c;
+
+	if (cat_domain == NULL || cat_lang == NULL) {
+		__atomic_store_n(&cur, NULL, __ATOMIC_RELEASE);
+		return;
+	}
+
+	for (c = catalogs; c; c = c->next) {
+		if (!strcmp(c->domain, cat_domain) && !strcmp(c->lang, cat_lang))
+			break;
+	}
+
+	if (c == NULL) {
+		c = calloc(1, sizeof(struct catalog));
+		_ret_if(c == NULL);
+
+		c->domain = strdup(cat_domain);
+		c->lang = strdup(cat_lang);
+		if (c->domain == NULL || c->lang == NULL) {
+			free(c->domain);
+			free(c->lang);
+			free(c);
+			return;
+		}
+
+		__load(c, cat_dir);
+
+		c->next = catalogs;
+		catalogs = c;
+	}
+
+	__atomic_store_n(&cur, c, __ATOMIC_RELEASE);
+}
+
+static char *__replace(char *old, const char *s)
+{
+	char *n;
+
+	n = s ? strdup(s) : NULL;
+	free(old);
+
+	return n;
+}
+
+void catalog_set_domain(const char *domain, const char *dir)
+{
+	cat_domain = __replace(cat_domain, domain);
+	cat_dir = __replace(cat_dir, dir);
+
+	__switch();
+}
+
+void catalog_set_lang(const char *lang)
+{
+	_ret_if(cat_lang && lang && !strcmp(cat_lang, lang));
+
+	cat_lang = __replace(cat_lang, lang);
+
+	__switch();
+}
+
+static const char *__lookup(const struct catalog *c, const char *msgid)
+{
+	unsigned int h;
+	unsigned int idx;
+	unsigned int incr;
+	unsigned int n;
+	unsigned int i;
+	unsigned int lo;
+	unsigned int hi;
+	const char *s;
+	int r;
+
+	if (c->hash) {
+		h = __hash(msgid);
+		idx = h % c->hash_size;
+		incr = 1 + (h % (c->hash_size - 2));
+
+		for (i = 0; i < c->hash_size; i++) {
+			n = __w(c, c->hash[idx]);
+			if (n == 0)
+				return NULL;
+
+			n--;
+			if (n < c->nstrings) {
+				s = __str(c, &c->orig[n]);
+				if (s && !strcmp(s, msgid))
+					return __str(c, &c->trans[n]);
+			}
+
+			if (idx >= c->hash_size - incr)
+				idx -= c->hash_size - incr;
+			else
+				idx += incr;
+		}
+
+		return NULL;
+	}
+
+	lo = 0;
+	hi = c->nstrings;
+	while (lo < hi) {
+		n = (lo + hi) / 2;
+		s = __str(c, &c->orig[n]);
+		if (s == NULL)
+			return NULL;
+
+		r = strcmp(msgid, s);
+		if (r == 0)
+			return __str(c, &c->trans[n]);
+		if (r < 0)
+			hi = n;
+		else
+			lo = n + 1;
+	}
+
+	return NULL;
+}
+
+/* NULL if there is no catalog mapped for the language */
+const char *catalog_find(const char *msgid)
+{
+	const struct catalog *c;
+	const char *s;
+
+	c = __atomic_load_n(&cur, __ATOMIC_ACQUIRE);
+	if (c == NULL || c->map == NULL)
+		return NULL;
+
+	s = __lookup(c, msgid);
+	if (s == NULL || s[0] == '\0')
+		return msgid;
+
+	return s;
+}
@@ -182,6 +182,8 @@ static void __do_app(enum app_event event, void *data, bundle * b)
 		    ui->name);
 		if (ui->ops->reset)
 			r = ui->ops->reset(b, ui->ops->data);
+		if (ui->state == AS_PAUSED)
+			appcore_resume_rotation_cb();
 		ui->state = AS_RUNNING;
 		LOG(LOG_DEBUG, "LAUNCH", "[%s:Application:reset:done]",
 		    ui->name);
@@ -194,9 +196,8 @@ static void __do_app(enum app_event event, void *data, bundle * b)
 			ui->state = AS_PAUSED;
 			if(r >= 0 && resource_reclaiming == TRUE)
 				__appcore_timer_add(ui);
+			appcore_pause_rotation_cb();
 		}
-		/* TODO : rotation stop */
-		//r = appcore_pause_rotation_cb();
 
 		sysman_inform_backgrd();
 		break;
@@ -209,8 +210,7 @@ static void __do_app(enum app_event event, void *data, bundle * b)
 				r = ui->ops->resume(ui->ops->data);
 			ui->state = AS_RUNNING;
 		}
-		/*TODO : rotation start*/
-		//r = appcore_resume_rotation_cb();
+		appcore_resume_rotation_cb();
 		LOG(LOG_DEBUG, "LAUNCH", "[%s:Application:resume:done]",
 		    ui->name);
 		LOG(LOG_DEBUG, "LAUNCH", "[%s:Application:Launching:done]",
@@ -374,6 +374,9 @@ static Eina_Bool __show_cb(void *data, int type, void *event)
 	else
 		__update_win((unsigned int)ev->win, FALSE);
 
+	appcore_x_add_win((unsigned int)ev->win);
+	appcore_x_win_shown((unsigned int)ev->win);
+
 	return ECORE_CALLBACK_RENEW;
 }
 
@@ -388,7 +391,8 @@ static Eina_Bool __hide_cb(void *data, int type, void *event)
 
 	if (__exist_win((unsigned int)ev->win)) {
 		__delete_win((unsigned int)ev->win);
-		
+		appcore_x_del_win((unsigned int)ev->win);
+
 		bvisibility = __check_visible();
 		if (!bvisibility && b_active == 1) {
 			_DBG(" Go to Pasue state \n");
@@ -408,6 +412,8 @@ static Eina_Bool __visibility_cb(void *data, int type, void *event)
 	ev = event;
 
 	__update_win((unsigned int)ev->win, ev->fully_obscured);
+	if (!ev->fully_obscured)
+		appcore_x_win_shown((unsigned int)ev->win);
 	bvisibility = __check_visible();
 
 	if (bvisibility && b_active == 0) {
@@ -428,13 +434,13 @@ static Eina_Bool __visibility_cb(void *data, int type, void *event)
 
 static void __add_climsg_cb(struct ui_priv *ui)
 {
+	const struct x_ctx *x;
+
 	_ret_if(ui == NULL);
 
-	atom_parent = ecore_x_atom_get("_E_PARENT_BORDER_WINDOW");
-	if (!atom_parent)
-	{
-		// Do Error Handling
-	}
+	x = appcore_x_get_ctx();
+	if (x)
+		atom_parent = x->atoms[X_ATOM_E_PARENT_BORDER_WINDOW];
 
 	ui->hshow =
 	    ecore_event_handler_add(ECORE_X_EVENT_WINDOW_SHOW, __show_cb, ui);
@@ -456,6 +462,9 @@ static int __before_loop(struct ui_priv *ui, int *argc, char ***argv)
 		return -1;
 	}
 
+	/* overlaps elm_init(), joined by appcore_init() */
+	appcore_startup_run(ui->name, *argc, *argv);
+
 	g_type_init();
 	elm_init(*argc, *argv);
 
@@ -463,6 +472,17 @@ static int __before_loop(struct ui_priv *ui, int *argc, char ***argv)
 	_retv_if(r == -1, -1);
 
 	LOG(LOG_DEBUG, "LAUNCH", "[%s:Platform:appcore_init:done]", ui->name);
+	if (ui->ops) {
+		/* the tasks run while create() does */
+		r = appcore_task_start(ui->name, ui->ops->tasks,
+				       ui->ops->data);
+		if (r == -1) {
+			_ERR("startup tasks are not valid");
+			appcore_exit();
+			return -1;
+		}
+	}
+
 	if (ui->ops && ui->ops->create) {
 		r = ui->ops->create(ui->ops->data);
 		if (r == -1) {
@@ -475,6 +495,7 @@ static int __before_loop(struct ui_priv *ui, int *argc, char ***argv)
 		    ui->name);
 	}
 	ui->state = AS_CREATED;
+	appcore_task_release();
 
 	__add_climsg_cb(ui);
 
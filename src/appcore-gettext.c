@@ -0,0 +1,213 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <libintl.h>
+#include <pthread.h>
+
+#include "appcore-internal.h"
+
+/*
+ * Translations already looked up, so labels translated again on every
+ * relayout or rotation skip the lookup. Messages of the default domain are
+ * looked up in the mapped catalog first, then with libintl. The table is
+ * dropped when the language changes and on low memory.
+ */
+
+#define MSGCACHE_BUCKETS 256	/* power of 2 */
+#define MSGCACHE_MAX 1024	/* entries before the table is dropped */
+
+struct msg_ent {
+	char *domain;		/* NULL for the default domain */
+	char *msgid;
+	const char *str;	/* NULL if msgid is not translated */
+
+	unsigned int hash;
+	struct msg_ent *next;
+};
+
+static struct msg_ent *msgs[MSGCACHE_BUCKETS];
+static unsigned int nmsgs;
+static unsigned int msgs_gen;	/* generation of the entries */
+static unsigned int msg_gen;	/* bumped when the language changes */
+static pthread_mutex_t msg_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static unsigned int __hash(const char *domain, const char *msgid)
+{
+	unsigned int h = 5381;
+
+	while (*msgid)
+		h = h * 33 + (unsigned char)*msgid++;
+
+	if (domain) {
+		while (*domain)
+			h = h * 33 + (unsigned char)*domain++;
+	}
+
+	return h;
+}
+
+static int __streq(const char *a, const char *b)
+{
+	if (a == b)
+		return 1;
+	if (a == NULL || b == NULL)
+		return 0;
+
+	return !strcmp(a, b);
+}
+
+static void __clear(void)
+{
+	int i;
+	struct msg_ent *e;
+	struct msg_ent *next;
+
+	for (i = 0; i < MSGCACHE_BUCKETS; i++) {
+		for (e = msgs[i]; e; e = next) {
+			next = e->next;
+			free(e->domain);
+			free(e->msgid);
+			free(e);
+		}
+		msgs[i] = NULL;
+	}
+	nmsgs = 0;
+}
+
+static struct msg_ent *__find(const char *domain, const char *msgid,
+			      unsigned int h)
+{
+	struct msg_ent *e;
+
+	for (e = msgs[h & (MSGCACHE_BUCKETS - 1)]; e; e = e->next) {
+		if (e->hash == h && !strcmp(e->msgid, msgid) &&
+		    __streq(e->domain, domain))
+			return e;
+	}
+
+	return NULL;
+}
+
+static void __add(const char *domain, const char *msgid, unsigned int h,
+		  const char *str)
+{
+	struct msg_ent *e;
+
+	if (nmsgs >= MSGCACHE_MAX) {
+		_DBG("[APP %d] message cache full, dropped", getpid());
+		__clear();
+	}
+
+	e = calloc(1, sizeof(struct msg_ent));
+	_ret_if(e == NULL);
+
+	e->msgid = strdup(msgid);
+	e->domain = domain ? strdup(domain) : NULL;
+	if (e->msgid == NULL || (domain && e->domain == NULL)) {
+		free(e->msgid);
+		free(e->domain);
+		free(e);
+		return;
+	}
+
+	/* untranslated messages return the caller's string */
+	e->str = str != msgid ? str : NULL;
+	e->hash = h;
+
+	e->next = msgs[h & (MSGCACHE_BUCKETS - 1)];
+	msgs[h & (MSGCACHE_BUCKETS - 1)] = e;
+	nmsgs++;
+}
+
+static char *__gettext(const char *domain, const char *msgid)
+{
+	struct msg_ent *e;
+	unsigned int h;
+	unsigned int gen;
+	const char *str;
+
+	if (msgid == NULL) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	i18n_load();
+
+	h = __hash(domain, msgid);
+
+	pthread_mutex_lock(&msg_lock);
+	gen = __atomic_load_n(&msg_gen, __ATOMIC_ACQUIRE);
+	if (msgs_gen != gen) {
+		__clear();
+		msgs_gen = gen;
+	}
+
+	e = __find(domain, msgid, h);
+	if (e) {
+		str = e->str ? : msgid;
+		pthread_mutex_unlock(&msg_lock);
+		return (char *)str;
+	}
+	pthread_mutex_unlock(&msg_lock);
+
+	/* the mapped catalogs are never unmapped, str can be kept */
+	if (domain)
+		str = dgettext(domain, msgid);
+	else if ((str = catalog_find(msgid)) == NULL)
+		str = gettext(msgid);
+
+	pthread_mutex_lock(&msg_lock);
+	/* not kept if the language changed in the meantime */
+	if (msgs_gen == __atomic_load_n(&msg_gen, __ATOMIC_ACQUIRE) &&
+	    __find(domain, msgid, h) == NULL)
+		__add(domain, msgid, h, str);
+	pthread_mutex_unlock(&msg_lock);
+
+	return (char *)str;
+}
+
+void msgcache_invalidate(void)
+{
+	__atomic_add_fetch(&msg_gen, 1, __ATOMIC_RELEASE);
+}
+
+void msgcache_flush(void)
+{
+	pthread_mutex_lock(&msg_lock);
+	__clear();
+	pthread_mutex_unlock(&msg_lock);
+}
+
+EXPORT_API char *appcore_gettext(const char *msgid)
+{
+	return __gettext(NULL, msgid);
+}
+
+EXPORT_API char *appcore_dgettext(const char *domainname, const char *msgid)
+{
+	return __gettext(domainname, msgid);
+}
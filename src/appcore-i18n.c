@@ -20,53 +20,398 @@
  */
 
 
+#define _GNU_SOURCE
+
 #include <locale.h>
+#include <langinfo.h>
 #include <libintl.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
 #include <errno.h>
+#include <pthread.h>
 
+#include <glib.h>
 #include <vconf.h>
 
 #include "appcore-internal.h"
 
+#define LOCALE_CACHE_MAX 4
+
+/* every category but LC_MESSAGES follows the region format */
+#define REGION_MASK (LC_CTYPE_MASK | LC_NUMERIC_MASK | LC_TIME_MASK | \
+		     LC_COLLATE_MASK | LC_MONETARY_MASK | LC_PAPER_MASK | \
+		     LC_NAME_MASK | LC_ADDRESS_MASK | LC_TELEPHONE_MASK | \
+		     LC_MEASUREMENT_MASK | LC_IDENTIFICATION_MASK)
+
+#define LC_NCAT 11		/* categories of REGION_MASK */
+
+#define LC_DATA_MAX (16 * 1024 * 1024)	/* larger spans are not compared */
+
+struct loc_ent {
+	char *lang;
+	char *region;
+	locale_t loc;
+	unsigned int used;	/* for LRU */
+};
+
+static const struct lc_cat {
+	int cat;
+	int mask;
+	const char *env;
+} lc_cats[LC_NCAT] = {
+	{ LC_CTYPE, LC_CTYPE_MASK, "LC_CTYPE" },
+	{ LC_NUMERIC, LC_NUMERIC_MASK, "LC_NUMERIC" },
+	{ LC_TIME, LC_TIME_MASK, "LC_TIME" },
+	{ LC_COLLATE, LC_COLLATE_MASK, "LC_COLLATE" },
+	{ LC_MONETARY, LC_MONETARY_MASK, "LC_MONETARY" },
+	{ LC_PAPER, LC_PAPER_MASK, "LC_PAPER" },
+	{ LC_NAME, LC_NAME_MASK, "LC_NAME" },
+	{ LC_ADDRESS, LC_ADDRESS_MASK, "LC_ADDRESS" },
+	{ LC_TELEPHONE, LC_TELEPHONE_MASK, "LC_TELEPHONE" },
+	{ LC_MEASUREMENT, LC_MEASUREMENT_MASK, "LC_MEASUREMENT" },
+	{ LC_IDENTIFICATION, LC_IDENTIFICATION_MASK, "LC_IDENTIFICATION" },
+};
+
+/* how the items of a category are compared */
+enum {
+	LC_STR,		/* strings */
+	LC_BYTE,	/* one byte values */
+	LC_WORD,	/* 32 bit values */
+	LC_DATA,	/* the data from the first item up to the last one */
+};
+
+/*
+ * The data which tells two locales apart, per category. The tables of
+ * LC_CTYPE and LC_COLLATE have no size of their own, they are compared as
+ * the span they take in the locale file, where the items are in order.
+ */
+static const struct lc_item {
+	int mask;
+	nl_item first;
+	nl_item last;
+	int type;
+} lc_items[] = {
+	{ LC_CTYPE_MASK, _NL_CTYPE_CLASS, _NL_CTYPE_EXTRA_MAP_14, LC_DATA },
+	{ LC_NUMERIC_MASK, RADIXCHAR, GROUPING, LC_STR },
+	{ LC_TIME_MASK, ABDAY_1, T_FMT_AMPM, LC_STR },
+	{ LC_TIME_MASK, ERA_D_FMT, ERA_D_FMT, LC_STR },
+	{ LC_TIME_MASK, _NL_TIME_FIRST_WEEKDAY, _NL_TIME_FIRST_WEEKDAY, LC_BYTE },
+	{ LC_TIME_MASK, _DATE_FMT, _DATE_FMT, LC_STR },
+	{ LC_COLLATE_MASK, _NL_COLLATE_NRULES, _NL_COLLATE_NRULES, LC_WORD },
+	{ LC_COLLATE_MASK, _NL_COLLATE_RULESETS, _NL_COLLATE_CODESET, LC_DATA },
+	{ LC_MONETARY_MASK, INT_CURR_SYMBOL, NEGATIVE_SIGN, LC_STR },
+	{ LC_MONETARY_MASK, INT_FRAC_DIGITS, N_SIGN_POSN, LC_BYTE },
+	{ LC_MONETARY_MASK, CRNCYSTR, CRNCYSTR, LC_STR },
+	{ LC_PAPER_MASK, _NL_PAPER_HEIGHT, _NL_PAPER_WIDTH, LC_WORD },
+	{ LC_NAME_MASK, _NL_NAME_NAME_FMT, _NL_NAME_NAME_MS, LC_STR },
+	{ LC_ADDRESS_MASK, _NL_ADDRESS_POSTAL_FMT, _NL_ADDRESS_COUNTRY_CAR,
+	  LC_STR },
+	{ LC_ADDRESS_MASK, _NL_ADDRESS_COUNTRY_NUM, _NL_ADDRESS_COUNTRY_NUM,
+	  LC_WORD },
+	{ LC_ADDRESS_MASK, _NL_ADDRESS_COUNTRY_ISBN, _NL_ADDRESS_LANG_LIB,
+	  LC_STR },
+	{ LC_TELEPHONE_MASK, _NL_TELEPHONE_TEL_INT_FMT,
+	  _NL_TELEPHONE_INT_PREFIX, LC_STR },
+	{ LC_MEASUREMENT_MASK, _NL_MEASUREMENT_MEASUREMENT,
+	  _NL_MEASUREMENT_MEASUREMENT, LC_BYTE },
+	{ LC_IDENTIFICATION_MASK, _NL_IDENTIFICATION_TITLE,
+	  _NL_IDENTIFICATION_CATEGORY, LC_STR },
+};
+
 static int _set;
 
+/*
+ * In the lazy mode, appcore_init() only records the text domain. The
+ * locale is loaded on the first idle, or before by the first lookup of
+ * the main thread.
+ */
+static int lazy;
+static int pending;
+static char *pending_domain;
+static char *pending_dir;
+static guint pending_idler;
+static pthread_t pending_thread;	/* the main loop, which loads it */
+static pthread_mutex_t pending_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static char *cur_lang;
+static char *cur_region;
+static locale_t cur_loc;
+static int region_changes;	/* LC_*_MASK of the last region change */
+
+static struct loc_ent cache[LOCALE_CACHE_MAX];
+static unsigned int tick;
+
+/*
+ * Worker threads get a copy of cur_loc. The lock is only taken to make
+ * the copy and to free a cache entry, formatting never waits for it.
+ */
+struct thread_loc {
+	locale_t loc;
+	unsigned int gen;
+};
+
+static pthread_mutex_t loc_lock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned int loc_gen = 1;	/* bumped when cur_loc changes */
+static pthread_key_t loc_key;
+static pthread_once_t loc_once = PTHREAD_ONCE_INIT;
+
+static int __streq(const char *a, const char *b)
+{
+	return !strcmp(a ? : "", b ? : "");
+}
+
+static locale_t __new_locale(const char *lang, const char *region)
+{
+	locale_t base;
+	locale_t loc;
+
+	base = newlocale(LC_ALL_MASK, lang, (locale_t)0);
+	_retvm_if(base == (locale_t)0, (locale_t)0,
+		  "appcore: newlocale(%s) error", lang);
+
+	if (region == NULL || region[0] == '\0')
+		return base;
+
+	/* on failure base is kept as is, the language is used for all */
+	loc = newlocale(REGION_MASK, region, base);
+	if (loc == (locale_t)0) {
+		_DBG("appcore: newlocale(%s) error, use %s", region, lang);
+		return base;
+	}
+
+	return loc;
+}
+
+static struct loc_ent *__get_locale(const char *lang, const char *region)
+{
+	int i;
+	locale_t loc;
+	struct loc_ent *e;
+	struct loc_ent *victim;
+
+	victim = NULL;
+	for (i = 0; i < LOCALE_CACHE_MAX; i++) {
+		e = &cache[i];
+		if (e->loc && __streq(e->lang, lang) &&
+		    __streq(e->region, region)) {
+			e->used = ++tick;
+			return e;
+		}
+
+		/* the one in use by the main thread stays */
+		if (e->loc && e->loc == cur_loc)
+			continue;
+		if (victim == NULL || e->loc == (locale_t)0 ||
+		    (victim->loc && e->used < victim->used))
+			victim = e;
+	}
+	_retv_if(victim == NULL, NULL);
+
+	loc = __new_locale(lang, region);
+	_retv_if(loc == (locale_t)0, NULL);
+
+	if (victim->loc) {
+		pthread_mutex_lock(&loc_lock);
+		freelocale(victim->loc);
+		pthread_mutex_unlock(&loc_lock);
+		free(victim->lang);
+		free(victim->region);
+	}
+
+	victim->lang = lang ? strdup(lang) : NULL;
+	victim->region = region ? strdup(region) : NULL;
+	victim->loc = loc;
+	victim->used = ++tick;
+
+	return victim;
+}
+
+/* the entries update_lang() and update_region() will look for */
+void i18n_prewarm(void)
+{
+	char *lang;
+	char *region;
+
+	lang = vconf_get_str(VCONFKEY_LANGSET);
+	_ret_if(lang == NULL);
+
+	__get_locale(lang, cur_region);
+
+	region = vconf_get_str(VCONFKEY_REGIONFORMAT);
+	if (region)
+		__get_locale(lang, region);
+
+	free(lang);
+	free(region);
+}
+
+static struct loc_ent *__apply(void)
+{
+	struct loc_ent *e;
+
+	_retv_if(cur_lang == NULL, NULL);
+
+	e = __get_locale(cur_lang, cur_region);
+	_retv_if(e == NULL, NULL);
+
+	/* the main thread switches, the archives are not read again */
+	uselocale(e->loc);
+
+	pthread_mutex_lock(&loc_lock);
+	cur_loc = e->loc;
+	__atomic_add_fetch(&loc_gen, 1, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&loc_lock);
+
+	return e;
+}
+
+static struct loc_ent *__cur_ent(void)
+{
+	int i;
+
+	for (i = 0; i < LOCALE_CACHE_MAX; i++) {
+		if (cur_loc && cache[i].loc == cur_loc)
+			return &cache[i];
+	}
+
+	return NULL;
+}
+
+static unsigned int __word(nl_item item, locale_t loc)
+{
+	/* the value itself is returned in place of a string */
+	return (unsigned int)(unsigned long)nl_langinfo_l(item, loc);
+}
+
+static int __same(const struct lc_item *it, locale_t a, locale_t b)
+{
+	const char *pa;
+	const char *pb;
+	unsigned long na;
+	unsigned long nb;
+	nl_item i;
+
+	if (it->type == LC_DATA) {
+		/* without rules, strings are collated as by strcmp() */
+		if (it->first == _NL_COLLATE_RULESETS &&
+		    __word(_NL_COLLATE_NRULES, a) == 0 &&
+		    __word(_NL_COLLATE_NRULES, b) == 0)
+			return 1;
+
+		pa = nl_langinfo_l(it->first, a);
+		pb = nl_langinfo_l(it->first, b);
+		na = (unsigned long)nl_langinfo_l(it->last, a) - (unsigned long)pa;
+		nb = (unsigned long)nl_langinfo_l(it->last, b) - (unsigned long)pb;
+
+		/* shared, as the locale archive stores equal data once */
+		if (pa == pb && na == nb)
+			return 1;
+		if (pa == NULL || pb == NULL || na != nb || na > LC_DATA_MAX)
+			return 0;
+
+		return !memcmp(pa, pb, na);
+	}
+
+	for (i = it->first; i <= it->last; i++) {
+		switch (it->type) {
+		case LC_STR:
+			if (!__streq(nl_langinfo_l(i, a), nl_langinfo_l(i, b)))
+				return 0;
+			break;
+		case LC_BYTE:
+			if (nl_langinfo_l(i, a)[0] != nl_langinfo_l(i, b)[0])
+				return 0;
+			break;
+		case LC_WORD:
+			if (__word(i, a) != __word(i, b))
+				return 0;
+			break;
+		}
+	}
+
+	return 1;
+}
+
+/* categories whose data differ, en_US and en_GB share LC_COLLATE */
+static int __changed(struct loc_ent *a, struct loc_ent *b)
+{
+	int changed = 0;
+	int i;
+
+	for (i = 0; i < sizeof(lc_items) / sizeof(lc_items[0]); i++) {
+		if (changed & lc_items[i].mask)
+			continue;
+		if (!__same(&lc_items[i], a->loc, b->loc))
+			changed |= lc_items[i].mask;
+	}
+
+	return changed;
+}
+
+static void __free_thread_loc(void *data)
+{
+	struct thread_loc *t = data;
+
+	if (t->loc) {
+		if (uselocale((locale_t)0) == t->loc)
+			uselocale(LC_GLOBAL_LOCALE);
+		freelocale(t->loc);
+	}
+	free(t);
+}
+
+static void __init_key(void)
+{
+	pthread_key_create(&loc_key, __free_thread_loc);
+}
+
 void update_lang(void)
 {
 	char *lang;
-	char *r;
 
 	lang = vconf_get_str(VCONFKEY_LANGSET);
 	if (lang) {
 		setenv("LANG", lang, 1);
 		setenv("LC_MESSAGES", lang, 1);
-		r = setlocale(LC_ALL, "");
-		if (r == NULL) {
-			r = setlocale(LC_ALL, vconf_get_str(VCONFKEY_LANGSET));
-			_DBG("*****appcore setlocale=%s\n", r);
-		}
-		free(lang);
+
+		free(cur_lang);
+		cur_lang = lang;
+		__apply();
+		catalog_set_lang(lang);
+		msgcache_invalidate();
 	}
 }
 
 void update_region(void)
 {
 	char *region;
+	struct loc_ent *prev;
+	struct loc_ent *e;
+	int changed;
+	int i;
 
 	region = vconf_get_str(VCONFKEY_REGIONFORMAT);
 	if (region) {
-		setenv("LC_CTYPE", region, 1);
-		setenv("LC_NUMERIC", region, 1);
-		setenv("LC_TIME", region, 1);
-		setenv("LC_COLLATE", region, 1);
-		setenv("LC_MONETARY", region, 1);
-		setenv("LC_PAPER", region, 1);
-		setenv("LC_NAME", region, 1);
-		setenv("LC_ADDRESS", region, 1);
-		setenv("LC_TELEPHONE", region, 1);
-		setenv("LC_MEASUREMENT", region, 1);
-		setenv("LC_IDENTIFICATION", region, 1);
-		free(region);
+		/* the first region is applied to every category */
+		prev = cur_region ? __cur_ent() : NULL;
+
+		free(cur_region);
+		cur_region = region;
+		e = __apply();
+
+		changed = REGION_MASK;
+		if (prev && e)
+			changed = __changed(prev, e);
+
+		for (i = 0; i < LC_NCAT; i++) {
+			if (changed & lc_cats[i].mask)
+				setenv(lc_cats[i].env, region, 1);
+		}
+
+		region_changes = changed;
+		_DBG("[APP %d] region %s, changed categories 0x%x", getpid(),
+		     region, changed);
 	}
 }
 
@@ -79,10 +424,15 @@ static int __set_i18n(const char *domain, const char *dir)
 		return -1;
 	}
 
+	/*
+	 * The global locale is set once, for the threads which do not ask for
+	 * appcore_get_locale(). It maps the same archive data as the cached
+	 * objects, and is not set again on a change.
+	 */
 	r = setlocale(LC_ALL, "");
 	/* if locale is not set properly, try again to set as language base */
 	if (r == NULL) {
-		r = setlocale(LC_ALL, vconf_get_str(VCONFKEY_LANGSET));
+		r = setlocale(LC_ALL, cur_lang);
 		_DBG("*****appcore setlocale=%s\n", r);
 	}
 	_retvm_if(r == NULL, -1, "appcore: setlocale() error");
@@ -90,45 +440,202 @@ static int __set_i18n(const char *domain, const char *dir)
 	r = bindtextdomain(domain, dir);
 	_retvm_if(r == NULL, -1, "appcore: bindtextdomain() error");
 
+	/* r is the base directory in use, dir may be NULL */
+	catalog_set_domain(domain, r);
+	msgcache_invalidate();
+
 	r = textdomain(domain);
 	_retvm_if(r == NULL, -1, "appcore: textdomain() error");
 
 	return 0;
 }
 
+static void __clear_pending(void)
+{
+	free(pending_domain);
+	free(pending_dir);
+	pending_domain = NULL;
+	pending_dir = NULL;
+
+	if (pending_idler) {
+		g_source_remove(pending_idler);
+		pending_idler = 0;
+	}
+
+	__atomic_store_n(&pending, 0, __ATOMIC_RELEASE);
+}
+
 EXPORT_API int appcore_set_i18n(const char *domainname, const char *dirname)
 {
 	int r;
 
+	/* the deferred domain is replaced */
+	pthread_mutex_lock(&pending_lock);
+	if (pending)
+		__clear_pending();
+
 	update_lang();
 	update_region();
 
 	r = __set_i18n(domainname, dirname);
 	if (r == 0)
 		_set = 1;
+	pthread_mutex_unlock(&pending_lock);
 
 	return r;
 }
 
+void i18n_load(void)
+{
+	int r;
+
+	_ret_if(!__atomic_load_n(&pending, __ATOMIC_ACQUIRE));
+
+	/*
+	 * setenv() and uselocale() of the load belong to the main thread.
+	 * Other threads keep the C locale until the idler has run.
+	 */
+	_ret_if(!pthread_equal(pthread_self(), pending_thread));
+
+	pthread_mutex_lock(&pending_lock);
+	if (pending) {
+		update_lang();
+		update_region();
+
+		r = __set_i18n(pending_domain, pending_dir);
+		if (r == -1)
+			_ERR("[APP %d] deferred i18n of %s failed", getpid(),
+			     pending_domain);
+		__clear_pending();
+	}
+	pthread_mutex_unlock(&pending_lock);
+}
+
+static gboolean __load_idle(gpointer data)
+{
+	/* the source is removed by __clear_pending() */
+	i18n_load();
+
+	return FALSE;
+}
+
+static int __defer(const char *domainname, const char *dirname)
+{
+	char *domain;
+	char *dir;
+
+	domain = strdup(domainname);
+	dir = dirname ? strdup(dirname) : NULL;
+	if (domain == NULL || (dirname && dir == NULL)) {
+		free(domain);
+		free(dir);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	pthread_mutex_lock(&pending_lock);
+	if (pending)
+		__clear_pending();
+	pending_domain = domain;
+	pending_dir = dir;
+	pending_idler = g_idle_add(__load_idle, NULL);
+	pending_thread = pthread_self();
+	__atomic_store_n(&pending, 1, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&pending_lock);
+
+	return 0;
+}
+
 int set_i18n(const char *domainname, const char *dirname)
 {
 	_retv_if(_set, 0);
 
+	if (lazy) {
+		if (domainname == NULL) {
+			errno = EINVAL;
+			return -1;
+		}
+		return __defer(domainname, dirname);
+	}
+
 	update_lang();
 	update_region();
 
 	return __set_i18n(domainname, dirname);
 }
 
+EXPORT_API int appcore_set_lazy_i18n(int enable)
+{
+	lazy = enable ? 1 : 0;
+
+	return 0;
+}
+
+EXPORT_API locale_t appcore_get_locale(void)
+{
+	struct thread_loc *t;
+	locale_t loc;
+	unsigned int gen;
+
+	i18n_load();
+	pthread_once(&loc_once, __init_key);
+
+	t = pthread_getspecific(loc_key);
+	gen = __atomic_load_n(&loc_gen, __ATOMIC_ACQUIRE);
+	if (t && t->loc && t->gen == gen)
+		return t->loc;
+
+	if (t == NULL) {
+		t = calloc(1, sizeof(struct thread_loc));
+		_retv_if(t == NULL, LC_GLOBAL_LOCALE);
+		pthread_setspecific(loc_key, t);
+	}
+
+	pthread_mutex_lock(&loc_lock);
+	gen = loc_gen;
+	loc = duplocale(cur_loc ? : LC_GLOBAL_LOCALE);
+	pthread_mutex_unlock(&loc_lock);
+
+	if (loc == (locale_t)0) {
+		_ERR("appcore: duplocale() error");
+		return t->loc ? : LC_GLOBAL_LOCALE;
+	}
+
+	if (t->loc) {
+		/* the thread may be using the old copy */
+		if (uselocale((locale_t)0) == t->loc)
+			uselocale(loc);
+		freelocale(t->loc);
+	}
+
+	t->loc = loc;
+	t->gen = gen;
+
+	return loc;
+}
+
+EXPORT_API int appcore_get_region_changes(void)
+{
+	return region_changes;
+}
+
 EXPORT_API int appcore_get_timeformat(enum appcore_time_format *timeformat)
 {
 	int r;
+	struct appcore_settings s;
 
 	if (timeformat == NULL) {
 		errno = EINVAL;
 		return -1;
 	}
 
+	/* kept up to date by the notification while running */
+	r = settings_get(&s);
+	if (r == 0) {
+		*timeformat = s.timeformat;
+		return 0;
+	}
+
 	r = vconf_get_int(VCONFKEY_REGIONFORMAT_TIME1224, (int *)timeformat);
 
 	if (r < 0) {
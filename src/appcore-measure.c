@@ -27,6 +27,7 @@
 #include "appcore-internal.h"
 
 static struct timeval tv_s;	/* measure start */
+static struct timeval tv_r;	/* resume request received */
 
 static inline int __get_msec(struct timeval *s, struct timeval *e)
 {
@@ -91,3 +92,33 @@ EXPORT_API void appcore_measure_start(void)
 {
 	gettimeofday(&tv_s, NULL);
 }
+
+void measure_resume_start(void)
+{
+	gettimeofday(&tv_r, NULL);
+}
+
+EXPORT_API int appcore_measure_resume_time(void)
+{
+	int msec;
+
+	msec = __get_time(&tv_r);
+	timerclear(&tv_r);
+
+	return msec;
+}
+
+/* hist[0] counts < 1 msec, hist[i] counts < 2^i msec, the last one the rest */
+EXPORT_API void appcore_measure_hist_add(unsigned int *hist, int n,
+					 unsigned int msec)
+{
+	int i;
+
+	i = 0;
+	while (msec && i < n - 1) {
+		msec >>= 1;
+		i++;
+	}
+
+	hist[i]++;
+}
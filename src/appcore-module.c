@@ -0,0 +1,179 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#include <errno.h>
+#include <dlfcn.h>
+
+#include "appcore-internal.h"
+
+/*
+ * The X window and rotation code live in their own libraries, so that
+ * an app which never uses them does not load X11 or the sensor framework.
+ * They are loaded on first use and stay loaded, they register callbacks
+ * to the main loop and to the sensor daemon.
+ */
+
+static const struct appcore_x_ops *x_ops;
+static const struct appcore_rot_ops *rot_ops;
+
+static const void *__load(const char *name, const char *sym, int load)
+{
+	void *dl;
+	const void *ops;
+
+	/* without load, only pick up a module someone else loaded */
+	dl = dlopen(name, RTLD_NOW | (load ? 0 : RTLD_NOLOAD));
+	if (dl == NULL) {
+		if (load)
+			_ERR("dlopen %s failed: %s", name, dlerror());
+		return NULL;
+	}
+
+	ops = dlsym(dl, sym);
+	if (ops == NULL) {
+		_ERR("dlsym %s failed: %s", sym, dlerror());
+		dlclose(dl);
+		return NULL;
+	}
+
+	return ops;
+}
+
+static const struct appcore_x_ops *__x(int load)
+{
+	if (x_ops == NULL)
+		x_ops = __load(APPCORE_X_MODULE, APPCORE_X_MODULE_SYM, load);
+
+	return x_ops;
+}
+
+static const struct appcore_rot_ops *__rot(int load)
+{
+	if (rot_ops == NULL) {
+		rot_ops = __load(APPCORE_ROT_MODULE, APPCORE_ROT_MODULE_SYM,
+				 load);
+		if (rot_ops == NULL && load)
+			errno = ENOSYS;
+	}
+
+	return rot_ops;
+}
+
+int x_raise_win(pid_t pid)
+{
+	_retv_if(__x(1) == NULL, -1);
+
+	return x_ops->raise_win(pid);
+}
+
+void x_exit(void)
+{
+	_ret_if(__x(0) == NULL);
+
+	x_ops->exit();
+}
+
+EXPORT_API int appcore_set_rotation_cb(int (*cb) (enum appcore_rm, void *),
+				       void *data)
+{
+	_retv_if(__rot(1) == NULL, -1);
+
+	return rot_ops->set_cb(cb, data);
+}
+
+EXPORT_API int appcore_remove_rotation_cb(int (*cb) (enum appcore_rm, void *),
+					  void *data)
+{
+	if (__rot(0) == NULL) {
+		errno = ENOENT;
+		return -1;
+	}
+
+	return rot_ops->remove_cb(cb, data);
+}
+
+EXPORT_API int appcore_unset_rotation_cb(void)
+{
+	_retv_if(__rot(0) == NULL, 0);
+
+	return rot_ops->unset_cb();
+}
+
+EXPORT_API int appcore_get_rotation_state(enum appcore_rm *curr)
+{
+	if (curr == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (__rot(1) == NULL) {
+		*curr = APPCORE_RM_UNKNOWN;
+		return -1;
+	}
+
+	return rot_ops->get_state(curr);
+}
+
+EXPORT_API int appcore_pause_rotation_cb(void)
+{
+	_retv_if(__rot(0) == NULL, 0);
+
+	return rot_ops->pause();
+}
+
+EXPORT_API int appcore_resume_rotation_cb(void)
+{
+	_retv_if(__rot(0) == NULL, 0);
+
+	return rot_ops->resume();
+}
+
+EXPORT_API int appcore_set_rotation_filter(unsigned int dwell,
+					   unsigned int hysteresis)
+{
+	_retv_if(__rot(1) == NULL, -1);
+
+	return rot_ops->set_filter(dwell, hysteresis);
+}
+
+EXPORT_API int appcore_set_rotation_frame_sync(int enable)
+{
+	_retv_if(__rot(1) == NULL, -1);
+
+	return rot_ops->set_frame_sync(enable);
+}
+
+EXPORT_API int appcore_get_rotation_latency(enum appcore_rot_latency type,
+					    unsigned int *hist, int n)
+{
+	_retv_if(__rot(1) == NULL, -1);
+
+	return rot_ops->get_latency(type, hist, n);
+}
+
+EXPORT_API void appcore_reset_rotation_latency(void)
+{
+	_ret_if(__rot(0) == NULL);
+
+	rot_ops->reset_latency();
+}
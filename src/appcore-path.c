@@ -0,0 +1,175 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <linux/limits.h>
+#include <aul.h>
+
+#include "appcore-internal.h"
+
+/*
+ * The package and its root directory, resolved once. The launcher puts
+ * the application under one of the roots and passes its path in argv[0],
+ * so neither the AUL daemon nor the file system is asked in most cases.
+ */
+
+#define PKGNAME_MAX 256
+#define PATH_APP_ROOT "/opt/apps"
+#define PATH_RO_APP_ROOT "/usr/apps"
+#define PATH_RES "/res"
+
+static const char *roots[] = {
+	PATH_APP_ROOT,
+	PATH_RO_APP_ROOT,
+};
+
+static const char *argv0;
+static pthread_once_t path_once = PTHREAD_ONCE_INIT;
+
+static char pkg_name[PKGNAME_MAX];
+static char pkg_root[PATH_MAX];
+static char res_path[sizeof(pkg_root) + sizeof(PATH_RES)];
+
+/* /opt/apps/<pkg>/bin/<exe> gives <pkg> and /opt/apps/<pkg> */
+static int __from_path(const char *path)
+{
+	int i;
+	size_t len;
+	const char *s;
+	const char *e;
+
+	_retv_if(path == NULL || path[0] != '/', -1);
+
+	for (i = 0; i < sizeof(roots) / sizeof(roots[0]); i++) {
+		len = strlen(roots[i]);
+		if (strncmp(path, roots[i], len) || path[len] != '/')
+			continue;
+
+		s = path + len + 1;
+		e = strchr(s, '/');
+		if (e == NULL || e == s || e - s >= PKGNAME_MAX)
+			return -1;
+
+		snprintf(pkg_name, sizeof(pkg_name), "%.*s", (int)(e - s), s);
+		snprintf(pkg_root, sizeof(pkg_root), "%.*s", (int)(e - path),
+			 path);
+		return 0;
+	}
+
+	return -1;
+}
+
+static int __from_exe(void)
+{
+	char path[PATH_MAX];
+	ssize_t r;
+
+	r = readlink("/proc/self/exe", path, sizeof(path) - 1);
+	_retv_if(r <= 0, -1);
+	path[r] = '\0';
+
+	return __from_path(path);
+}
+
+/* only the name is known, the last root is kept if none is readable */
+static void __from_name(void)
+{
+	int i;
+
+	for (i = 0; i < sizeof(roots) / sizeof(roots[0]); i++) {
+		snprintf(pkg_root, sizeof(pkg_root), "%s/%s", roots[i],
+			 pkg_name);
+		if (access(pkg_root, R_OK) == 0)
+			return;
+	}
+}
+
+static void __resolve(void)
+{
+	const char *s;
+	int r;
+
+	r = __from_path(argv0);
+	if (r == 0)
+		goto out;
+
+	r = __from_exe();
+	if (r == 0)
+		goto out;
+
+	s = getenv(ENV_PKGNAME);
+	if (s && s[0]) {
+		snprintf(pkg_name, sizeof(pkg_name), "%s", s);
+		__from_name();
+		goto out;
+	}
+
+	r = aul_app_get_pkgname_bypid(getpid(), pkg_name, sizeof(pkg_name));
+	if (r != AUL_R_OK || pkg_name[0] == '\0') {
+		_ERR("[APP %d] package is not found", getpid());
+		pkg_name[0] = '\0';
+		return;
+	}
+	__from_name();
+
+ out:
+	snprintf(res_path, sizeof(res_path), "%s" PATH_RES, pkg_root);
+	_DBG("[APP %d] package %s, res %s", getpid(), pkg_name, res_path);
+}
+
+void path_init(int argc, char **argv)
+{
+	if (argc > 0 && argv)
+		argv0 = argv[0];
+
+	pthread_once(&path_once, __resolve);
+}
+
+EXPORT_API const char *appcore_get_pkgname(void)
+{
+	pthread_once(&path_once, __resolve);
+
+	if (pkg_name[0] == '\0') {
+		errno = ENOENT;
+		return NULL;
+	}
+
+	return pkg_name;
+}
+
+EXPORT_API const char *appcore_get_res_path(void)
+{
+	pthread_once(&path_once, __resolve);
+
+	if (res_path[0] == '\0') {
+		errno = ENOENT;
+		return NULL;
+	}
+
+	return res_path;
+}
@@ -22,6 +22,7 @@
 
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <sensor.h>
@@ -32,29 +33,35 @@
 
 #include "appcore-internal.h"
 
-#define _MAKE_ATOM(a, s)                              \
-   do {                                               \
-        a = ecore_x_atom_get(s);                      \
-        if (!a)                                       \
-          _ERR("##s creation failed.\n");             \
-   } while(0)
-
-#define STR_ATOM_ROTATION_LOCK                "_E_ROTATION_LOCK"
-
 static Ecore_X_Atom ATOM_ROTATION_LOCK = 0;
 static Ecore_X_Window root;
+static Display *disp;
+
+#define ROT_CB_GROW 4
+
+struct rot_cb {
+	int (*callback) (enum appcore_rm, void *);
+	void *cbdata;
+};
 
 struct rot_s {
 	int handle;
-	int (*callback) (enum appcore_rm, void *);
+	struct rot_cb *cbs;	/* removed entries have a NULL callback */
+	int ncbs;		/* used entries */
+	int size;		/* allocated entries */
+	int nactive;		/* registered callbacks */
+	int dispatching;
 	enum appcore_rm mode;
 	int lock;
-	void *cbdata;
 	int cb_set;
 	int sf_started;
+	enum appcore_rm curr;	/* last known mode, kept while stopped */
+	int curr_valid;		/* curr follows the sensor events */
 };
 static struct rot_s rot;
 
+static int __get_rotation_state(enum appcore_rm *curr);
+
 struct rot_evt {
 	enum accelerometer_rotate_state re;
 	enum appcore_rm rm;
@@ -80,8 +87,28 @@ static struct rot_evt re_to_rm[] = {
 };
 
 static enum appcore_rm changed_m;
-static void *changed_data;
 static Ecore_Event_Handler *changed_handle;
+static int lock_watched;	/* PropertyChangeMask on root selected by us */
+static int lock_held;		/* _E_ROTATION_LOCK, valid while watching */
+
+#define ROT_FILTER_MAX 10000	/* msec */
+
+static struct rot_filter filter;
+static Ecore_Timer *filter_timer;
+
+static int frame_sync;
+static enum appcore_rm frame_m;
+static Ecore_Animator *frame_anim;
+
+struct rot_lat {
+	enum appcore_rm m;	/* mode of the stamped sensor event */
+	unsigned int evt;	/* sensor event arrived */
+	unsigned int lock;	/* lock wait started */
+	unsigned int cb;	/* callbacks invoked */
+	unsigned int hist[APPCORE_ROT_LATENCY_MAX][APPCORE_ROT_LATENCY_BUCKETS];
+};
+static struct rot_lat lat;
+static Ecore_Idle_Enterer *lat_enterer;
 
 static enum appcore_rm __get_mode(int event_data)
 {
@@ -100,6 +127,143 @@ static enum appcore_rm __get_mode(int event_data)
 	return m;
 }
 
+static unsigned int __now(void)
+{
+	return (unsigned int)(ecore_time_get() * 1000);
+}
+
+static void __lat_add(enum appcore_rot_latency type, unsigned int since)
+{
+	appcore_measure_hist_add(lat.hist[type], APPCORE_ROT_LATENCY_BUCKETS,
+				 __now() - since);
+}
+
+static void __del_lat(void)
+{
+	if (lat_enterer) {
+		ecore_idle_enterer_del(lat_enterer);
+		lat_enterer = NULL;
+	}
+	lat.evt = 0;
+	lat.lock = 0;
+}
+
+static Eina_Bool __lat_frame(void *data)
+{
+	lat_enterer = NULL;
+
+	/* runs after the canvas render idle enterers of this loop */
+	__lat_add(APPCORE_ROT_LATENCY_FRAME, lat.cb);
+	_DBG("[APP %d] Rotation: callback to frame %u msec", getpid(),
+	     __now() - lat.cb);
+
+	return ECORE_CALLBACK_CANCEL;
+}
+
+static void __compact(void)
+{
+	int i;
+	int n;
+
+	n = 0;
+	for (i = 0; i < rot.ncbs; i++) {
+		if (rot.cbs[i].callback)
+			rot.cbs[n++] = rot.cbs[i];
+	}
+	rot.ncbs = n;
+}
+
+static void __notify(enum appcore_rm m)
+{
+	int i;
+	int n;
+
+	rot.mode = m;
+
+	lat.cb = __now();
+	if (lat.evt && lat.m == m) {
+		__lat_add(APPCORE_ROT_LATENCY_EVENT, lat.evt);
+		_DBG("[APP %d] Rotation: event to callback %u msec", getpid(),
+		     lat.cb - lat.evt);
+	}
+	lat.evt = 0;
+
+	/* callbacks added during the dispatch get the next change */
+	n = rot.ncbs;
+
+	rot.dispatching++;
+	for (i = 0; i < n; i++) {
+		if (rot.cbs[i].callback)
+			rot.cbs[i].callback(m, rot.cbs[i].cbdata);
+	}
+	rot.dispatching--;
+
+	if (rot.dispatching == 0)
+		__compact();
+
+	if (lat_enterer == NULL)
+		lat_enterer = ecore_idle_enterer_add(__lat_frame, NULL);
+}
+
+static void __del_frame(void)
+{
+	if (frame_anim) {
+		ecore_animator_del(frame_anim);
+		frame_anim = NULL;
+	}
+}
+
+static Eina_Bool __frame(void *data)
+{
+	frame_anim = NULL;
+
+	if (rot.nactive && rot.cb_set && rot.mode != frame_m)
+		__notify(frame_m);
+
+	return ECORE_CALLBACK_CANCEL;
+}
+
+static void __deliver(enum appcore_rm m)
+{
+	if (!frame_sync) {
+		__notify(m);
+		return;
+	}
+
+	/* only the last mode before the next frame is delivered */
+	frame_m = m;
+	if (frame_anim == NULL)
+		frame_anim = ecore_animator_add(__frame, NULL);
+}
+
+static int __get_lock(void)
+{
+	int ret;
+	unsigned int val;
+
+	val = 0;
+	ret = ecore_x_window_prop_card32_get(root, ATOM_ROTATION_LOCK, &val, 1);
+
+	return ret >= 1 && val;
+}
+
+static void __unwatch_lock(void)
+{
+	XWindowAttributes attr;
+
+	if (changed_handle) {
+		ecore_event_handler_del(changed_handle);
+		changed_handle = NULL;
+	}
+
+	if (lock_watched && XGetWindowAttributes(disp, root, &attr))
+		XSelectInput(disp, root,
+			     attr.your_event_mask & ~PropertyChangeMask);
+
+	lock_watched = 0;
+	lock_held = 0;
+}
+
 static Eina_Bool __property(void *data, int type, void *event)
 {
 	Ecore_X_Event_Window_Property *ev = event;
@@ -107,30 +271,120 @@ static Eina_Bool __property(void *data, int type, void *event)
 	if (!ev)
 		return ECORE_CALLBACK_PASS_ON;
 
-	if (ev->atom == ATOM_ROTATION_LOCK) {
+	if (ev->win == root && ev->atom == ATOM_ROTATION_LOCK) {
 		_DBG("[APP %d] Rotation: %d -> %d, cb_set : %d", getpid(), rot.mode, changed_m, rot.cb_set);
-		if (rot.cb_set && rot.mode != changed_m) {
-			rot.callback(changed_m, changed_data);
-			rot.mode = changed_m;
-		}
+		if (lock_held)
+			__lat_add(APPCORE_ROT_LATENCY_LOCK, lat.lock);
 
-		ecore_event_handler_del(changed_handle);
-		changed_handle = NULL;
+		if (rot.cb_set && rot.mode != changed_m)
+			__deliver(changed_m);
+
+		__unwatch_lock();
 	}
 
 	return ECORE_CALLBACK_PASS_ON;
 }
 
+static void __watch_lock(void)
+{
+	XWindowAttributes attr;
+
+	if (changed_handle == NULL)
+		changed_handle = ecore_event_handler_add(ECORE_X_EVENT_WINDOW_PROPERTY, __property, NULL);
+
+	/* root property events are wanted only until the lock goes away */
+	if (lock_watched || disp == NULL)
+		return;
+
+	if (!XGetWindowAttributes(disp, root, &attr))
+		return;
+
+	/* selected by somebody else in this client, leave it to them */
+	if (attr.your_event_mask & PropertyChangeMask)
+		return;
+
+	XSelectInput(disp, root, attr.your_event_mask | PropertyChangeMask);
+	lock_watched = 1;
+}
+
+static void __rotate(enum appcore_rm m)
+{
+	_ret_if(rot.nactive == 0);
+
+	/* a newer mode replaces the one waiting for the frame */
+	__del_frame();
+
+	/* while the lock is held, __property() delivers the last mode */
+	if (rot.cb_set && rot.mode != m && !lock_held) {
+		if (!__get_lock()) {
+			_DBG("[APP %d] Rotation: %d -> %d", getpid(), rot.mode, m);
+			__deliver(m);
+		} else {
+			__watch_lock();
+
+			/* the lock may be gone before the selection was made */
+			if (__get_lock()) {
+				_DBG("[APP %d] Rotation: %d -> %d, locked", getpid(), rot.mode, m);
+				lock_held = 1;
+				lat.lock = __now();
+			} else {
+				__unwatch_lock();
+				__deliver(m);
+			}
+		}
+	}
+	changed_m = m;
+}
+
+static void __del_filter_timer(void)
+{
+	if (filter_timer) {
+		ecore_timer_del(filter_timer);
+		filter_timer = NULL;
+	}
+}
+
+static Eina_Bool __filter_expired(void *data)
+{
+	enum appcore_rm m;
+
+	filter_timer = NULL;
+
+	m = rot_filter_expire(&filter, __now());
+	if (m != APPCORE_RM_UNKNOWN)
+		__rotate(m);
+
+	return ECORE_CALLBACK_CANCEL;
+}
+
+static void __filter(enum appcore_rm m)
+{
+	int r;
+
+	__del_filter_timer();
+
+	if (filter.dwell == 0 && filter.hysteresis == 0) {
+		__rotate(m);
+		return;
+	}
+
+	r = rot_filter_feed(&filter, m, __now());
+	if (r > 0) {
+		/* 1 msec more, the timer may fire a bit early */
+		filter_timer = ecore_timer_add((r + 1) / 1000.0,
+					       __filter_expired, NULL);
+		return;
+	}
+
+	if (m != APPCORE_RM_UNKNOWN)
+		__rotate(m);
+}
+
 static void __changed_cb(unsigned int event_type, sensor_event_data_t *event,
 		       void *data)
 {
 	int *cb_event_data;
 	enum appcore_rm m;
-	int ret;
-	int val;
-
-	if (rot.lock)
-		return;
 
 	if (event_type != ACCELEROMETER_EVENT_ROTATION_CHECK) {
 		errno = EINVAL;
@@ -141,35 +395,28 @@ static void __changed_cb(unsigned int event_type, sensor_event_data_t *event,
 
 	m = __get_mode(*cb_event_data);
 
-	_DBG("[APP %d] Rotation: %d -> %d", getpid(), rot.mode, m);
+	rot.curr = m;
+	rot.curr_valid = 1;
 
-	if (rot.callback) {
-		if (rot.cb_set && rot.mode != m) {
-			ret = ecore_x_window_prop_card32_get(root, ATOM_ROTATION_LOCK, &val, 1);
+	if (rot.lock)
+		return;
 
-			_DBG("[APP %d] Rotation: %d -> %d, val : %d, ret : %d", getpid(), rot.mode, m, val, ret);
-			if (!val || ret < 1) {
-				rot.callback(m, data);
-				rot.mode = m;
-			} else {
-				changed_data = data;
-				if(changed_handle) {
-					 ecore_event_handler_del(changed_handle);
-  					 changed_handle = NULL;
-				}
-				changed_handle = ecore_event_handler_add(ECORE_X_EVENT_WINDOW_PROPERTY, __property, NULL);
-			}
-		}
-		changed_m = m;
+
+	/* the sensor event has no timestamp, stamp it on arrival */
+	if (lat.evt == 0 || lat.m != m) {
+		lat.evt = __now();
+		lat.m = m;
 	}
+
+	_DBG("[APP %d] Rotation: %d -> %d", getpid(), rot.mode, m);
+
+	__filter(m);
 }
 
 static void __lock_cb(keynode_t *node, void *data)
 {
 	int r;
 	enum appcore_rm m;
-	int ret;
-	int val;
 
 	rot.lock = vconf_keynode_get_bool(node);
 
@@ -179,31 +426,37 @@ static void __lock_cb(keynode_t *node, void *data)
 	}
 
 	_DBG("[APP %d] Rotation unlocked", getpid());
-	if (rot.callback) {
+	if (rot.nactive) {
 		if (rot.cb_set) {
-			r = appcore_get_rotation_state(&m);
+			r = __get_rotation_state(&m);
 			_DBG("[APP %d] Rotmode prev %d -> curr %d", getpid(),
 			     rot.mode, m);
-			if (!r && rot.mode != m) {
-				if(!val) {
-					rot.callback(m, data);
-					rot.mode = m;
-				} else {
-					changed_data = data;
-					if(changed_handle) {
-						 ecore_event_handler_del(changed_handle);
-  						 changed_handle = NULL;
-					}
-					changed_handle = ecore_event_handler_add(ECORE_X_EVENT_WINDOW_PROPERTY, __property, NULL);
-				}
+			if (!r) {
+				__del_filter_timer();
+				rot_filter_reset(&filter, m);
+				__rotate(m);
 			}
-
-			if(!r)
-				changed_m = m;
 		}
 	}
 }
 
+static void __resume_mode(void)
+{
+	enum appcore_rm m;
+
+	_ret_if(rot.nactive == 0 || rot.cb_set == 0);
+
+	/* the sensor is not asked, its first event corrects the mode */
+	m = rot.curr;
+	_DBG("[APP %d] Rotmode prev %d -> last %d", getpid(), rot.mode, m);
+	if (m != APPCORE_RM_UNKNOWN && rot.mode != m && rot.lock == 0) {
+		__del_filter_timer();
+		rot_filter_reset(&filter, m);
+		__del_frame();
+		__deliver(m);
+	}
+}
+
 static void __add_rotlock(void *data)
 {
 	int r;
@@ -227,21 +480,11 @@ static void __del_rotlock(void)
 	rot.lock = 0;
 }
 
-EXPORT_API int appcore_set_rotation_cb(int (*cb) (enum appcore_rm, void *),
-				       void *data)
+static int __start_sensor(void)
 {
 	int r;
 	int handle;
-
-	if (cb == NULL) {
-		errno = EINVAL;
-		return -1;
-	}
-
-	if (rot.callback != NULL) {
-		errno = EALREADY;
-		return -1;
-	}
+	const struct x_ctx *x;
 
 	handle = sf_connect(ACCELEROMETER_SENSOR);
 	if (handle < 0) {
@@ -250,7 +493,7 @@ EXPORT_API int appcore_set_rotation_cb(int (*cb) (enum appcore_rm, void *),
 	}
 
 	r = sf_register_event(handle, ACCELEROMETER_EVENT_ROTATION_CHECK,
-			      NULL, __changed_cb, data);
+			      NULL, __changed_cb, NULL);
 	if (r < 0) {
 		_ERR("sf_register_event failed: %d", r);
 		sf_disconnect(handle);
@@ -258,15 +501,11 @@ EXPORT_API int appcore_set_rotation_cb(int (*cb) (enum appcore_rm, void *),
 	}
 
 	rot.cb_set = 1;
-	rot.callback = cb;
-	rot.cbdata = data;
 
 	r = sf_start(handle, 0);
 	if (r < 0) {
 		_ERR("sf_start failed: %d", r);
 		sf_unregister_event(handle, ACCELEROMETER_EVENT_ROTATION_CHECK);
-		rot.callback = NULL;
-		rot.cbdata = NULL;
 		rot.cb_set = 0;
 		rot.sf_started = 0;
 		sf_disconnect(handle);
@@ -275,21 +514,29 @@ EXPORT_API int appcore_set_rotation_cb(int (*cb) (enum appcore_rm, void *),
 	rot.sf_started = 1;
 
 	rot.handle = handle;
-	__add_rotlock(data);
+	__add_rotlock(NULL);
 
-	_MAKE_ATOM(ATOM_ROTATION_LOCK, STR_ATOM_ROTATION_LOCK );
-	root =  ecore_x_window_root_first_get();
-	XSelectInput(ecore_x_display_get(), root, PropertyChangeMask);
+	x = appcore_x_get_ctx();
+	if (x) {
+		ATOM_ROTATION_LOCK = x->atoms[X_ATOM_E_ROTATION_LOCK];
+		root = x->root;
+		disp = x->d;
+	}
 
 	return 0;
 }
 
-EXPORT_API int appcore_unset_rotation_cb(void)
+static int __stop_sensor(void)
 {
 	int r;
 
-	_retv_if(rot.callback == NULL, 0);
+	/* the device may turn without an event from now on */
+	rot.curr_valid = 0;
 
+	__del_filter_timer();
+	__del_frame();
+	__unwatch_lock();
+	__del_lat();
 	__del_rotlock();
 
 	if (rot.cb_set) {
@@ -301,8 +548,6 @@ EXPORT_API int appcore_unset_rotation_cb(void)
 		}
 		rot.cb_set = 0;
 	}
-	rot.callback = NULL;
-	rot.cbdata = NULL;
 
 	if (rot.sf_started == 1) {
 		r = sf_stop(rot.handle);
@@ -323,7 +568,107 @@ EXPORT_API int appcore_unset_rotation_cb(void)
 	return 0;
 }
 
-EXPORT_API int appcore_get_rotation_state(enum appcore_rm *curr)
+static int __find_cb(int (*cb) (enum appcore_rm, void *), void *data)
+{
+	int i;
+
+	for (i = 0; i < rot.ncbs; i++) {
+		if (rot.cbs[i].callback == cb && rot.cbs[i].cbdata == data)
+			return i;
+	}
+
+	return -1;
+}
+
+static void __del_cb(int i)
+{
+	rot.cbs[i].callback = NULL;
+	rot.cbs[i].cbdata = NULL;
+	rot.nactive--;
+
+	/* the dispatch loop compacts the array when it is done */
+	if (rot.dispatching == 0)
+		__compact();
+}
+
+static int __set_rotation_cb(int (*cb) (enum appcore_rm, void *), void *data)
+{
+	int r;
+	int i;
+	struct rot_cb *cbs;
+
+	if (cb == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (__find_cb(cb, data) >= 0) {
+		errno = EALREADY;
+		return -1;
+	}
+
+	if (rot.ncbs == rot.size) {
+		cbs = realloc(rot.cbs,
+			      (rot.size + ROT_CB_GROW) * sizeof(struct rot_cb));
+		_retv_if(cbs == NULL, -1);
+		rot.cbs = cbs;
+		rot.size += ROT_CB_GROW;
+	}
+
+	i = rot.ncbs++;
+	rot.cbs[i].callback = cb;
+	rot.cbs[i].cbdata = data;
+	rot.nactive++;
+
+	/* the first listener connects the sensor, the others share it */
+	_retv_if(rot.nactive > 1, 0);
+
+	r = __start_sensor();
+	if (r < 0) {
+		__del_cb(i);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int __remove_rotation_cb(int (*cb) (enum appcore_rm, void *),
+				void *data)
+{
+	int i;
+
+	i = __find_cb(cb, data);
+	if (cb == NULL || i < 0) {
+		errno = ENOENT;
+		return -1;
+	}
+
+	__del_cb(i);
+
+	_retv_if(rot.nactive > 0, 0);
+
+	return __stop_sensor();
+}
+
+static int __unset_rotation_cb(void)
+{
+	int i;
+
+	_retv_if(rot.nactive == 0, 0);
+
+	for (i = 0; i < rot.ncbs; i++) {
+		rot.cbs[i].callback = NULL;
+		rot.cbs[i].cbdata = NULL;
+	}
+	rot.nactive = 0;
+
+	if (rot.dispatching == 0)
+		rot.ncbs = 0;
+
+	return __stop_sensor();
+}
+
+static int __get_rotation_state(enum appcore_rm *curr)
 {
 	int r;
 	unsigned long event;
@@ -333,6 +678,16 @@ EXPORT_API int appcore_get_rotation_state(enum appcore_rm *curr)
 		return -1;
 	}
 
+	/*
+	 * Sensor events keep the mode up to date while the sensor runs. When
+	 * it was stopped, the device may have turned, so the sensor is asked
+	 * until its first event after the restart.
+	 */
+	if (rot.sf_started && rot.curr_valid) {
+		*curr = rot.curr;
+		return 0;
+	}
+
 	r = sf_check_rotation(&event);
 	if (r < 0) {
 		_ERR("sf_check_rotation failed: %d", r);
@@ -341,17 +696,28 @@ EXPORT_API int appcore_get_rotation_state(enum appcore_rm *curr)
 	}
 
 	*curr = __get_mode(event);
+	rot.curr = *curr;
+	/* later changes come as events */
+	rot.curr_valid = rot.sf_started;
 
 	return 0;
 }
 
-EXPORT_API int appcore_pause_rotation_cb(void)
+static int __pause_rotation_cb(void)
 {
 	int r;
 
-	_retv_if(rot.callback == NULL, 0);
+	_retv_if(rot.nactive == 0, 0);
+	_retv_if(rot.cb_set == 0 && rot.sf_started == 0, 0);
 	_DBG("[APP %d] appcore_pause_rotation_cb is called", getpid());
 
+	/* the device may turn without an event from now on */
+	rot.curr_valid = 0;
+
+	__del_filter_timer();
+	__del_frame();
+	__unwatch_lock();
+	__del_lat();
 	__del_rotlock();
 
 	if (rot.cb_set) {
@@ -377,18 +743,18 @@ EXPORT_API int appcore_pause_rotation_cb(void)
 	return 0;
 }
 
-EXPORT_API int appcore_resume_rotation_cb(void)
+static int __resume_rotation_cb(void)
 {
 	int r;
-	enum appcore_rm m;
 
-	_retv_if(rot.callback == NULL, 0);
+	_retv_if(rot.nactive == 0, 0);
+	_retv_if(rot.cb_set == 1 && rot.sf_started == 1, 0);
 	_DBG("[APP %d] appcore_resume_rotation_cb is called", getpid());
 
 	if (rot.cb_set == 0) {
 		r = sf_register_event(rot.handle,
 				      ACCELEROMETER_EVENT_ROTATION_CHECK, NULL,
-				      __changed_cb, rot.cbdata);
+				      __changed_cb, NULL);
 		if (r < 0) {
 			_ERR("sf_register_event in appcore_internal_sf_start failed: %d", r);
 			return -1;
@@ -409,14 +775,80 @@ EXPORT_API int appcore_resume_rotation_cb(void)
 		rot.sf_started = 1;
 	}
 
-	__add_rotlock(rot.cbdata);
+	__add_rotlock(NULL);
+
+	/*
+	 * The last known mode is delivered now, in case it changed while
+	 * rotation was locked. The first sensor event corrects it if the
+	 * device turned while paused.
+	 */
+	__resume_mode();
 
-	r = appcore_get_rotation_state(&m);
-	_DBG("[APP %d] Rotmode prev %d -> curr %d", getpid(), rot.mode, m);
-	if (!r && rot.mode != m && rot.lock == 0) {
-		rot.callback(m, rot.cbdata);
-		rot.mode = m;
+	return 0;
+}
+
+static int __set_rotation_filter(unsigned int dwell, unsigned int hysteresis)
+{
+	if (dwell > ROT_FILTER_MAX || hysteresis > ROT_FILTER_MAX) {
+		errno = EINVAL;
+		return -1;
 	}
 
+	__del_filter_timer();
+
+	rot_filter_init(&filter, dwell, hysteresis);
+	rot_filter_reset(&filter, rot.mode);
+
 	return 0;
 }
+
+static int __set_rotation_frame_sync(int enable)
+{
+	frame_sync = !!enable;
+
+	if (!frame_sync && frame_anim) {
+		__del_frame();
+		if (rot.nactive && rot.cb_set && rot.mode != frame_m)
+			__notify(frame_m);
+	}
+
+	return 0;
+}
+
+static int __get_rotation_latency(enum appcore_rot_latency type,
+				  unsigned int *hist, int n)
+{
+	int i;
+
+	if (type < 0 || type >= APPCORE_ROT_LATENCY_MAX || hist == NULL ||
+	    n <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (n > APPCORE_ROT_LATENCY_BUCKETS)
+		n = APPCORE_ROT_LATENCY_BUCKETS;
+
+	for (i = 0; i < n; i++)
+		hist[i] = lat.hist[type][i];
+
+	return n;
+}
+
+static void __reset_rotation_latency(void)
+{
+	memset(lat.hist, 0, sizeof(lat.hist));
+}
+
+EXPORT_API const struct appcore_rot_ops appcore_rot_module = {
+	.set_cb = __set_rotation_cb,
+	.remove_cb = __remove_rotation_cb,
+	.unset_cb = __unset_rotation_cb,
+	.get_state = __get_rotation_state,
+	.pause = __pause_rotation_cb,
+	.resume = __resume_rotation_cb,
+	.set_filter = __set_rotation_filter,
+	.set_frame_sync = __set_rotation_frame_sync,
+	.get_latency = __get_rotation_latency,
+	.reset_latency = __reset_rotation_latency,
+};
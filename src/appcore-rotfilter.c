@@ -0,0 +1,101 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <string.h>
+
+#include "appcore-internal.h"
+
+static unsigned int __hold(struct rot_filter *f, enum appcore_rm m)
+{
+	if (m == f->prev)
+		return f->dwell + f->hysteresis;
+
+	return f->dwell;
+}
+
+static void __accept(struct rot_filter *f, enum appcore_rm m)
+{
+	f->prev = f->stable;
+	f->stable = m;
+	f->pending = APPCORE_RM_UNKNOWN;
+}
+
+void rot_filter_init(struct rot_filter *f, unsigned int dwell,
+		     unsigned int hysteresis)
+{
+	memset(f, 0, sizeof(struct rot_filter));
+	f->dwell = dwell;
+	f->hysteresis = hysteresis;
+}
+
+void rot_filter_reset(struct rot_filter *f, enum appcore_rm m)
+{
+	f->prev = APPCORE_RM_UNKNOWN;
+	f->stable = m;
+	f->pending = APPCORE_RM_UNKNOWN;
+}
+
+int rot_filter_feed(struct rot_filter *f, enum appcore_rm m, unsigned int now)
+{
+	unsigned int hold;
+	unsigned int elapsed;
+
+	_retv_if(m == APPCORE_RM_UNKNOWN, -1);
+
+	/* back to where we were, forget the candidate */
+	if (m == f->stable) {
+		f->pending = APPCORE_RM_UNKNOWN;
+		return -1;
+	}
+
+	if (f->stable == APPCORE_RM_UNKNOWN) {
+		__accept(f, m);
+		return 0;
+	}
+
+	if (m != f->pending) {
+		f->pending = m;
+		f->since = now;
+	}
+
+	hold = __hold(f, m);
+	elapsed = now - f->since;
+	if (elapsed >= hold) {
+		__accept(f, m);
+		return 0;
+	}
+
+	return hold - elapsed;
+}
+
+enum appcore_rm rot_filter_expire(struct rot_filter *f, unsigned int now)
+{
+	enum appcore_rm m;
+
+	m = f->pending;
+	_retv_if(m == APPCORE_RM_UNKNOWN, APPCORE_RM_UNKNOWN);
+	_retv_if(now - f->since < __hold(f, m), APPCORE_RM_UNKNOWN);
+
+	__accept(f, m);
+
+	return m;
+}
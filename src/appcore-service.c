@@ -0,0 +1,245 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <glib.h>
+#include "appcore-internal.h"
+#include "appcore-service.h"
+
+/*
+ * Appcore for background services: the lifecycle and system events of
+ * appcore-common on a plain glib main loop, without EFL or X.
+ */
+
+static pid_t _pid;
+
+struct svc_priv {
+	const char *name;
+	enum app_state state;
+
+	GMainLoop *loop;
+
+	struct appcore_ops *ops;
+};
+
+static struct svc_priv priv;
+
+static const char *_ae_name[AE_MAX] = {
+	[AE_UNKNOWN] = "UNKNOWN",
+	[AE_CREATE] = "CREATE",
+	[AE_TERMINATE] = "TERMINATE",
+	[AE_PAUSE] = "PAUSE",
+	[AE_RESUME] = "RESUME",
+	[AE_RESET] = "RESET",
+	[AE_LOWMEM_POST] = "LOWMEM_POST",
+	[AE_MEM_FLUSH] = "MEM_FLUSH",
+};
+
+static const char *_as_name[] = {
+	[AS_NONE] = "NONE",
+	[AS_CREATED] = "CREATED",
+	[AS_RUNNING] = "RUNNING",
+	[AS_PAUSED] = "PAUSED",
+	[AS_DYING] = "DYING",
+};
+
+static void __do_app(enum app_event event, void *data, bundle * b)
+{
+	struct svc_priv *svc = data;
+
+	_ret_if(svc == NULL || event >= AE_MAX);
+	_DBG("[APP %d] Event: %s State: %s", _pid, _ae_name[event],
+	     _as_name[svc->state]);
+
+	switch (event) {
+	case AE_TERMINATE:
+		_DBG("[APP %d] TERMINATE", _pid);
+		svc->state = AS_DYING;
+		if (svc->loop)
+			g_main_loop_quit(svc->loop);
+		break;
+	case AE_LOWMEM_POST:
+		/* a service is always in the background */
+		appcore_flush_memory();
+		break;
+	case AE_RESET:
+		_DBG("[APP %d] RESET", _pid);
+		LOG(LOG_DEBUG, "LAUNCH", "[%s:Application:reset:start]",
+		    svc->name);
+		if (svc->ops && svc->ops->reset)
+			svc->ops->reset(b, svc->ops->data);
+		svc->state = AS_RUNNING;
+		LOG(LOG_DEBUG, "LAUNCH", "[%s:Application:reset:done]",
+		    svc->name);
+		break;
+	case AE_RESUME:
+		_DBG("[APP %d] RESUME", _pid);
+		if (svc->ops && svc->ops->resume)
+			svc->ops->resume(svc->ops->data);
+		svc->state = AS_RUNNING;
+		break;
+	default:
+		/* no window, nothing to pause or to flush */
+		break;
+	}
+}
+
+static struct ui_ops svc_ops = {
+	.data = &priv,
+	.cb_app = __do_app,
+	.flags = UI_NO_WINDOW,
+};
+
+static int __before_loop(struct svc_priv *svc, int *argc, char ***argv)
+{
+	int r;
+
+	if (argc == NULL || argv == NULL) {
+		_ERR("argc/argv is NULL");
+		errno = EINVAL;
+		return -1;
+	}
+
+	r = appcore_init(svc->name, &svc_ops, *argc, *argv);
+	_retv_if(r == -1, -1);
+
+	LOG(LOG_DEBUG, "LAUNCH", "[%s:Platform:appcore_init:done]", svc->name);
+	r = appcore_task_start(svc->name, svc->ops->tasks,
+			       svc->ops->data);
+	if (r == -1) {
+		_ERR("startup tasks are not valid");
+		appcore_exit();
+		return -1;
+	}
+
+	if (svc->ops->create) {
+		r = svc->ops->create(svc->ops->data);
+		if (r == -1) {
+			_ERR("create() return error");
+			appcore_exit();
+			errno = ECANCELED;
+			return -1;
+		}
+		LOG(LOG_DEBUG, "LAUNCH", "[%s:Application:create:done]",
+		    svc->name);
+	}
+	svc->state = AS_CREATED;
+	appcore_task_release();
+
+	svc->loop = g_main_loop_new(NULL, FALSE);
+	if (svc->loop == NULL) {
+		appcore_exit();
+		errno = ENOMEM;
+		return -1;
+	}
+
+	return 0;
+}
+
+static void __after_loop(struct svc_priv *svc)
+{
+	appcore_exit();
+
+	if (svc->ops->terminate)
+		svc->ops->terminate(svc->ops->data);
+
+	g_main_loop_unref(svc->loop);
+	svc->loop = NULL;
+}
+
+static int __set_data(struct svc_priv *svc, const char *name,
+		      struct appcore_ops *ops)
+{
+	if (svc->name) {
+		_ERR("Mainloop already started");
+		errno = EINPROGRESS;
+		return -1;
+	}
+
+	if (name == NULL || name[0] == '\0') {
+		_ERR("Invalid name");
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (ops == NULL) {
+		_ERR("ops is NULL");
+		errno = EINVAL;
+		return -1;
+	}
+
+	svc->name = strdup(name);
+	_retv_if(svc->name == NULL, -1);
+
+	svc->ops = ops;
+
+	_pid = getpid();
+
+	return 0;
+}
+
+static void __unset_data(struct svc_priv *svc)
+{
+	if (svc->name)
+		free((void *)svc->name);
+
+	memset(svc, 0, sizeof(struct svc_priv));
+}
+
+EXPORT_API int appcore_service_main(const char *name, int *argc, char ***argv,
+				    struct appcore_ops *ops)
+{
+	int r;
+
+	LOG(LOG_DEBUG, "LAUNCH", "[%s:Application:main:done]", name);
+
+	r = __set_data(&priv, name, ops);
+	_retv_if(r == -1, -1);
+
+	r = __before_loop(&priv, argc, argv);
+	if (r == -1) {
+		__unset_data(&priv);
+		return -1;
+	}
+
+	/* AE_TERMINATE may come from create() or the first reset */
+	if (priv.state != AS_DYING)
+		g_main_loop_run(priv.loop);
+
+	__after_loop(&priv);
+
+	__unset_data(&priv);
+
+	return 0;
+}
+
+EXPORT_API void appcore_service_exit(void)
+{
+	_ret_if(priv.loop == NULL);
+
+	priv.state = AS_DYING;
+	g_main_loop_quit(priv.loop);
+}
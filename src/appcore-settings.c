@@ -0,0 +1,233 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <glib.h>
+#include <vconf.h>
+
+#include "appcore-internal.h"
+
+/*
+ * Snapshot of the settings, written by the main thread from the vconf
+ * notifications and read from any thread without a lock. The sequence is
+ * odd while the snapshot is written, readers retry if it changed.
+ */
+
+static struct appcore_settings snap;
+static unsigned int seq;
+static int snap_set;
+
+/*
+ * Few applications read the rotation lock, its notification is only added
+ * by the main loop after the first appcore_get_settings(). Until then it
+ * is read from the backend.
+ */
+enum {
+	LOCK_UNWATCHED,
+	LOCK_PENDING,
+	LOCK_WATCHED,
+};
+
+static int lock_watch;
+
+static void __begin(void)
+{
+	__atomic_store_n(&seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void __end(void)
+{
+	__atomic_store_n(&seq, seq + 1, __ATOMIC_RELEASE);
+}
+
+static void __set_str(char *dst, size_t size, char *s)
+{
+	_ret_if(s == NULL);
+
+	snprintf(dst, size, "%s", s);
+}
+
+static void __read(struct appcore_settings *s)
+{
+	int r;
+	int v;
+	char *str;
+
+	memset(s, 0, sizeof(struct appcore_settings));
+
+	r = vconf_get_int(VCONFKEY_REGIONFORMAT_TIME1224, &v);
+	s->timeformat = r < 0 ? APPCORE_TIME_FORMAT_UNKNOWN : v;
+
+	vconf_get_int(VCONFKEY_SYSMAN_LOW_MEMORY, &s->low_memory);
+	vconf_get_int(VCONFKEY_SYSMAN_BATTERY_STATUS_LOW, &s->low_battery);
+	vconf_get_bool(VCONFKEY_SETAPPL_ROTATE_LOCK_BOOL, &s->rotation_lock);
+
+	str = vconf_get_str(VCONFKEY_LANGSET);
+	__set_str(s->lang, sizeof(s->lang), str);
+	free(str);
+
+	str = vconf_get_str(VCONFKEY_REGIONFORMAT);
+	__set_str(s->region, sizeof(s->region), str);
+	free(str);
+}
+
+void settings_init(void)
+{
+	struct appcore_settings s;
+
+	__read(&s);
+
+	__begin();
+	snap = s;
+	__end();
+
+	__atomic_store_n(&snap_set, 1, __ATOMIC_RELEASE);
+}
+
+static void __lock_changed(keynode_t *key, void *data)
+{
+	settings_update(key);
+}
+
+static gboolean __watch_lock(gpointer data)
+{
+	int lock;
+
+	/* appcore_exit() was called in the meantime */
+	if (!snap_set) {
+		__atomic_store_n(&lock_watch, LOCK_UNWATCHED, __ATOMIC_RELEASE);
+		return FALSE;
+	}
+
+	vconf_notify_key_changed(VCONFKEY_SETAPPL_ROTATE_LOCK_BOOL,
+				 __lock_changed, NULL);
+
+	/* read after the notification is added, no change is missed */
+	if (vconf_get_bool(VCONFKEY_SETAPPL_ROTATE_LOCK_BOOL, &lock) == 0) {
+		__begin();
+		snap.rotation_lock = lock;
+		__end();
+	}
+
+	__atomic_store_n(&lock_watch, LOCK_WATCHED, __ATOMIC_RELEASE);
+
+	return FALSE;
+}
+
+static void __watch(void)
+{
+	int unwatched = LOCK_UNWATCHED;
+
+	if (__atomic_compare_exchange_n(&lock_watch, &unwatched, LOCK_PENDING,
+					0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		g_idle_add(__watch_lock, NULL);
+}
+
+void settings_exit(void)
+{
+	int watched = LOCK_WATCHED;
+
+	__atomic_store_n(&snap_set, 0, __ATOMIC_RELEASE);
+
+	/* a pending watch is dropped by __watch_lock() */
+	if (__atomic_compare_exchange_n(&lock_watch, &watched, LOCK_UNWATCHED,
+					0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		vconf_ignore_key_changed(VCONFKEY_SETAPPL_ROTATE_LOCK_BOOL,
+					 __lock_changed);
+}
+
+void settings_update(keynode_t *key)
+{
+	const char *name;
+
+	_ret_if(!snap_set);
+
+	name = vconf_keynode_get_name(key);
+	_ret_if(name == NULL);
+
+	__begin();
+
+	if (!strcmp(name, VCONFKEY_REGIONFORMAT_TIME1224))
+		snap.timeformat = vconf_keynode_get_int(key);
+	else if (!strcmp(name, VCONFKEY_SYSMAN_LOW_MEMORY))
+		snap.low_memory = vconf_keynode_get_int(key);
+	else if (!strcmp(name, VCONFKEY_SYSMAN_BATTERY_STATUS_LOW))
+		snap.low_battery = vconf_keynode_get_int(key);
+	else if (!strcmp(name, VCONFKEY_SETAPPL_ROTATE_LOCK_BOOL))
+		snap.rotation_lock = vconf_keynode_get_bool(key);
+	else if (!strcmp(name, VCONFKEY_LANGSET))
+		__set_str(snap.lang, sizeof(snap.lang),
+			  vconf_keynode_get_str(key));
+	else if (!strcmp(name, VCONFKEY_REGIONFORMAT))
+		__set_str(snap.region, sizeof(snap.region),
+			  vconf_keynode_get_str(key));
+
+	__end();
+}
+
+int settings_get(struct appcore_settings *s)
+{
+	unsigned int b;
+	unsigned int e;
+
+	_retv_if(!__atomic_load_n(&snap_set, __ATOMIC_ACQUIRE), -1);
+
+	do {
+		b = __atomic_load_n(&seq, __ATOMIC_ACQUIRE);
+		if (b & 1)
+			continue;
+
+		*s = snap;
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		e = __atomic_load_n(&seq, __ATOMIC_RELAXED);
+	} while ((b & 1) || b != e);
+
+	return 0;
+}
+
+EXPORT_API int appcore_get_settings(struct appcore_settings *settings)
+{
+	if (settings == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* not running yet, read the backend */
+	if (settings_get(settings) == -1) {
+		__read(settings);
+		return 0;
+	}
+
+	if (__atomic_load_n(&lock_watch, __ATOMIC_ACQUIRE) != LOCK_WATCHED) {
+		vconf_get_bool(VCONFKEY_SETAPPL_ROTATE_LOCK_BOOL,
+			       &settings->rotation_lock);
+		__watch();
+	}
+
+	return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "appcore-internal.h"
+
+/*
+ * Work of appcore_init() which does not depend on EFL, started on threads
+ * before elm_init() and joined by appcore_init(). The tasks only fill
+ * caches, the main thread applies the results after the join.
+ */
+
+struct startup_task {
+	const char *name;
+	void (*func) (void);
+
+	pthread_t thread;
+	int started;
+	struct timespec start;
+	struct timespec end;
+};
+
+static int s_argc;
+static char **s_argv;
+static const char *s_name;
+static int running;
+
+static void __path(void)
+{
+	path_init(s_argc, s_argv);
+}
+
+/*
+ * locale: vconf_get_str() reads the key from its backend file on each
+ * call and keeps no state between calls, so it may run beside elm_init().
+ * Appcore makes no other vconf call before startup_join(), and the locale
+ * cache the task fills is only used by the main thread after the join.
+ */
+static struct startup_task tasks[] = {
+	{ "path", __path, },
+	{ "locale", i18n_prewarm, },
+};
+
+#define NTASKS (sizeof(tasks) / sizeof(tasks[0]))
+
+static long __usec(const struct timespec *s, const struct timespec *e)
+{
+	return (e->tv_sec - s->tv_sec) * 1000000L +
+	    (e->tv_nsec - s->tv_nsec) / 1000;
+}
+
+static void *__run(void *data)
+{
+	struct startup_task *t = data;
+
+	clock_gettime(CLOCK_MONOTONIC, &t->start);
+	t->func();
+	clock_gettime(CLOCK_MONOTONIC, &t->end);
+
+	return NULL;
+}
+
+EXPORT_API void appcore_startup_run(const char *name, int argc, char **argv)
+{
+	int i;
+	int r;
+
+	_ret_if(running);
+
+	s_name = name;
+	s_argc = argc;
+	s_argv = argv;
+
+	for (i = 0; i < NTASKS; i++) {
+		r = pthread_create(&tasks[i].thread, NULL, __run, &tasks[i]);
+		if (r) {
+			/* on the caller then, it is only slower */
+			_ERR("[APP %d] startup task %s: %s", getpid(),
+			     tasks[i].name, strerror(r));
+			__run(&tasks[i]);
+			continue;
+		}
+		tasks[i].started = 1;
+	}
+
+	running = 1;
+}
+
+void startup_join(void)
+{
+	struct timespec s;
+	struct timespec e;
+	int i;
+
+	_ret_if(!running);
+
+	clock_gettime(CLOCK_MONOTONIC, &s);
+	for (i = 0; i < NTASKS; i++) {
+		if (tasks[i].started)
+			pthread_join(tasks[i].thread, NULL);
+		tasks[i].started = 0;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &e);
+
+	running = 0;
+
+	for (i = 0; i < NTASKS; i++) {
+		LOG(LOG_DEBUG, "LAUNCH",
+		    "[%s:Platform:startup:%s:done] %ld usec", s_name,
+		    tasks[i].name, __usec(&tasks[i].start, &tasks[i].end));
+	}
+	LOG(LOG_DEBUG, "LAUNCH", "[%s:Platform:startup:join] %ld usec waited",
+	    s_name, __usec(&s, &e));
+}
@@ -0,0 +1,384 @@
+/*
+ *  app-core
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Jayoun Lee <airjany@samsung.com>, Sewook Park <sewook7.park@samsung.com>, Jaeho Lee <jaeho81.lee@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "appcore-internal.h"
+
+/*
+ * Startup tasks of the application, appcore_ops.tasks. A few workers run
+ * every task whose dependencies are done, while create() runs on the main
+ * thread. The reset callback waits for the APPCORE_TASK_BEFORE_RESET ones.
+ */
+
+#define TASK_WORKERS_MAX 4
+
+enum task_state {
+	TS_WAIT,
+	TS_RUN,
+	TS_DONE,
+	TS_FAILED,		/* returned non-zero */
+	TS_SKIPPED,		/* a dependency failed */
+};
+
+struct task_ent {
+	const struct appcore_task *t;
+	enum task_state state;
+	int enabled;		/* APPCORE_TASK_AFTER_CREATE until released */
+
+	int *deps;		/* indexes */
+	int ndeps;
+	int left;		/* dependencies not finished */
+
+	struct timespec start;
+	struct timespec end;
+};
+
+static struct task_ent *ents;
+static int nents;
+static int nfinished;
+static int nbefore;		/* APPCORE_TASK_BEFORE_RESET not finished */
+static int quit;
+
+static const char *t_name;
+static void *t_data;
+
+static pthread_t workers[TASK_WORKERS_MAX];
+static int nworkers;
+static pthread_mutex_t t_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t t_cond = PTHREAD_COND_INITIALIZER;
+
+static long __usec(const struct timespec *s, const struct timespec *e)
+{
+	return (e->tv_sec - s->tv_sec) * 1000000L +
+	    (e->tv_nsec - s->tv_nsec) / 1000;
+}
+
+static int __find(const struct appcore_task *tasks, int n, const char *name)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		if (!strcmp(tasks[i].name, name))
+			return i;
+	}
+
+	return -1;
+}
+
+static void __free(void)
+{
+	int i;
+
+	for (i = 0; i < nents; i++)
+		free(ents[i].deps);
+	free(ents);
+
+	ents = NULL;
+	nents = 0;
+	nfinished = 0;
+	nbefore = 0;
+}
+
+/* names resolved, every task reachable in dependency order */
+static int __build(const struct appcore_task *tasks, int n)
+{
+	struct task_ent *e;
+	int *left;
+	int i;
+	int j;
+	int k;
+	int done;
+	int progress;
+
+	ents = calloc(n, sizeof(struct task_ent));
+	_retv_if(ents == NULL, -1);
+	nents = n;
+
+	for (i = 0; i < n; i++) {
+		e = &ents[i];
+		e->t = &tasks[i];
+		e->enabled = !(tasks[i].flags & APPCORE_TASK_AFTER_CREATE);
+		if (tasks[i].flags & APPCORE_TASK_BEFORE_RESET)
+			nbefore++;
+
+		if (__find(tasks, i, tasks[i].name) != -1) {
+			_ERR("task %s: declared twice", tasks[i].name);
+			goto err;
+		}
+
+		for (j = 0; tasks[i].deps && tasks[i].deps[j]; j++)
+			;
+		if (j == 0)
+			continue;
+
+		e->deps = calloc(j, sizeof(int));
+		if (e->deps == NULL)
+			goto err;
+
+		for (j = 0; tasks[i].deps[j]; j++) {
+			k = __find(tasks, n, tasks[i].deps[j]);
+			if (k == -1 || k == i) {
+				_ERR("task %s: bad dependency %s",
+				     tasks[i].name, tasks[i].deps[j]);
+				goto err;
+			}
+			e->deps[e->ndeps++] = k;
+		}
+		e->left = e->ndeps;
+	}
+
+	/* a cycle would never start, refuse it now */
+	left = calloc(n, sizeof(int));
+	if (left == NULL)
+		goto err;
+	for (i = 0; i < n; i++)
+		left[i] = ents[i].left;
+
+	done = 0;
+	do {
+		progress = 0;
+		for (i = 0; i < n; i++) {
+			if (left[i] != 0)
+				continue;
+			left[i] = -1;
+			done++;
+			progress = 1;
+
+			for (j = 0; j < n; j++) {
+				for (k = 0; k < ents[j].ndeps; k++) {
+					if (ents[j].deps[k] == i)
+						left[j]--;
+				}
+			}
+		}
+	} while (progress);
+	free(left);
+
+	if (done != n) {
+		_ERR("tasks of %s have a dependency cycle", t_name);
+		goto err;
+	}
+
+	return 0;
+
+ err:
+	__free();
+	errno = EINVAL;
+
+	return -1;
+}
+
+/* called with t_lock */
+static void __finish(int i, enum task_state state)
+{
+	int j;
+	int k;
+
+	ents[i].state = state;
+	nfinished++;
+	if (ents[i].t->flags & APPCORE_TASK_BEFORE_RESET)
+		nbefore--;
+
+	for (j = 0; j < nents; j++) {
+		for (k = 0; k < ents[j].ndeps; k++) {
+			if (ents[j].deps[k] == i)
+				ents[j].left--;
+		}
+	}
+
+	pthread_cond_broadcast(&t_cond);
+}
+
+/* called with t_lock */
+static struct task_ent *__next(void)
+{
+	struct task_ent *e;
+	int i;
+	int k;
+
+ again:
+	for (i = 0; i < nents; i++) {
+		e = &ents[i];
+		if (e->state != TS_WAIT || !e->enabled || e->left)
+			continue;
+
+		for (k = 0; k < e->ndeps; k++) {
+			if (ents[e->deps[k]].state != TS_DONE)
+				break;
+		}
+		if (k < e->ndeps) {
+			_ERR("task %s: skipped, a dependency failed",
+			     e->t->name);
+			__finish(i, TS_SKIPPED);
+			goto again;
+		}
+
+		e->state = TS_RUN;
+		return e;
+	}
+
+	return NULL;
+}
+
+static void *__worker(void *data)
+{
+	struct task_ent *e;
+	int r;
+
+	pthread_mutex_lock(&t_lock);
+	while (!quit && nfinished < nents) {
+		e = __next();
+		if (e == NULL) {
+			pthread_cond_wait(&t_cond, &t_lock);
+			continue;
+		}
+		pthread_mutex_unlock(&t_lock);
+
+		clock_gettime(CLOCK_MONOTONIC, &e->start);
+		r = e->t->func(t_data);
+		clock_gettime(CLOCK_MONOTONIC, &e->end);
+
+		LOG(LOG_DEBUG, "LAUNCH", "[%s:Application:task:%s:done] %ld usec",
+		    t_name, e->t->name, __usec(&e->start, &e->end));
+		if (r)
+			_ERR("task %s: returned %d", e->t->name, r);
+
+		pthread_mutex_lock(&t_lock);
+		__finish(e - ents, r ? TS_FAILED : TS_DONE);
+	}
+	pthread_mutex_unlock(&t_lock);
+
+	return NULL;
+}
+
+EXPORT_API int appcore_task_start(const char *name,
+				  const struct appcore_task *tasks, void *data)
+{
+	long ncpu;
+	int n;
+	int r;
+
+	_retv_if(tasks == NULL || tasks[0].name == NULL, 0);
+	_retv_if(ents != NULL, 0);
+
+	for (n = 0; tasks[n].name; n++) {
+		if (tasks[n].func == NULL) {
+			_ERR("task %s: no function", tasks[n].name);
+			errno = EINVAL;
+			return -1;
+		}
+	}
+
+	t_name = name;
+	t_data = data;
+	quit = 0;
+
+	r = __build(tasks, n);
+	_retv_if(r == -1, -1);
+
+	ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+	if (ncpu > n)
+		ncpu = n;
+	if (ncpu > TASK_WORKERS_MAX)
+		ncpu = TASK_WORKERS_MAX;
+	if (ncpu < 1)
+		ncpu = 1;
+
+	for (nworkers = 0; nworkers < ncpu; nworkers++) {
+		r = pthread_create(&workers[nworkers], NULL, __worker, NULL);
+		if (r)
+			break;
+	}
+
+	if (nworkers == 0) {
+		_ERR("task workers of %s: %s", name, strerror(r));
+		__free();
+		errno = r;
+		return -1;
+	}
+
+	return 0;
+}
+
+EXPORT_API void appcore_task_release(void)
+{
+	int i;
+
+	pthread_mutex_lock(&t_lock);
+	for (i = 0; i < nents; i++)
+		ents[i].enabled = 1;
+	pthread_cond_broadcast(&t_cond);
+	pthread_mutex_unlock(&t_lock);
+}
+
+void task_wait(void)
+{
+	struct timespec s;
+	struct timespec e;
+	int i;
+
+	pthread_mutex_lock(&t_lock);
+	if (nbefore == 0) {
+		pthread_mutex_unlock(&t_lock);
+		return;
+	}
+
+	/* released after create(), in case a task still waits for it */
+	for (i = 0; i < nents; i++)
+		ents[i].enabled = 1;
+	pthread_cond_broadcast(&t_cond);
+
+	clock_gettime(CLOCK_MONOTONIC, &s);
+	while (nbefore > 0)
+		pthread_cond_wait(&t_cond, &t_lock);
+	pthread_mutex_unlock(&t_lock);
+	clock_gettime(CLOCK_MONOTONIC, &e);
+
+	LOG(LOG_DEBUG, "LAUNCH", "[%s:Platform:task:wait] %ld usec waited",
+	    t_name, __usec(&s, &e));
+}
+
+void task_exit(void)
+{
+	int i;
+
+	_ret_if(ents == NULL);
+
+	/* the running tasks finish, the others are dropped */
+	pthread_mutex_lock(&t_lock);
+	quit = 1;
+	pthread_cond_broadcast(&t_cond);
+	pthread_mutex_unlock(&t_lock);
+
+	for (i = 0; i < nworkers; i++)
+		pthread_join(workers[i], NULL);
+	nworkers = 0;
+
+	__free();
+}
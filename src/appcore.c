@@ -39,10 +39,6 @@
 
 #define SQLITE_FLUSH_MAX		(1024*1024)
 
-#define PKGNAME_MAX 256
-#define PATH_APP_ROOT "/opt/apps"
-#define PATH_RO_APP_ROOT "/usr/apps"
-#define PATH_RES "/res"
 #define PATH_LOCALE "/locale"
 
 static struct appcore core;
@@ -135,22 +131,14 @@ static struct evt_ops evtops[] = {
 
 static int __get_dir_name(char *dirname)
 {
-	char pkg_name[PKGNAME_MAX];
+	const char *res;
 	int r;
-	int pid;
 
-	pid = getpid();
-	if (pid < 0)
-		return -1;
-
-	aul_app_get_pkgname_bypid(pid, pkg_name, PKGNAME_MAX);
+	res = appcore_get_res_path();
+	_retv_if(res == NULL, -1);
 
-	r = snprintf(dirname, PATH_MAX, PATH_APP_ROOT "/%s" PATH_RES PATH_LOCALE,pkg_name);
-	if (r < 0)
-		return -1;
-	if (access(dirname, R_OK) == 0) return 0;
-	r = snprintf(dirname, PATH_MAX, PATH_RO_APP_ROOT "/%s" PATH_RES PATH_LOCALE,pkg_name);
-	if (r < 0)
+	r = snprintf(dirname, PATH_MAX, "%s" PATH_LOCALE, res);
+	if (r < 0 || r >= PATH_MAX)
 		return -1;
 
 	return 0;
@@ -187,6 +175,9 @@ static int __app_reset(void *data, bundle * k)
 
 	g_idle_add(__prt_ltime, ac);
 
+	/* APPCORE_TASK_BEFORE_RESET tasks are done before the first reset */
+	task_wait();
+
 	ac->ops->cb_app(AE_RESET, ac->ops->data, k);
 
 	return 0;
@@ -194,7 +185,20 @@ static int __app_reset(void *data, bundle * k)
 
 static int __app_resume(void *data)
 {
-	x_raise_win(getpid());
+	int r;
+	struct appcore *ac = data;
+
+	if (ac && ac->ops && (ac->ops->flags & UI_NO_WINDOW)) {
+		ac->ops->cb_app(AE_RESUME, ac->ops->data, NULL);
+		return 0;
+	}
+
+	/* ended when the raised window is shown */
+	measure_resume_start();
+	r = x_raise_win(getpid());
+	if (r == -1)
+		appcore_measure_resume_time();
+
 	return 0;
 }
 
@@ -231,6 +235,7 @@ static int __sys_do(struct appcore *ac, enum sys_event event)
 
 static int __sys_lowmem_post(void *data, void *evt)
 {
+	msgcache_flush();
 #if defined(MEMORY_FLUSH_ACTIVATE)
 	struct appcore *ac = data;
 	ac->ops->cb_app(AE_LOWMEM_POST, ac->ops->data, NULL);
@@ -305,6 +310,9 @@ static void __vconf_cb(keynode_t *key, void *data)
 
 	_DBG("[APP %d] vconf changed: %s", _pid, name);
 
+	/* before the callbacks, they may read the settings */
+	settings_update(key);
+
 	for (i = 0; i < sizeof(evtops) / sizeof(evtops[0]); i++) {
 		struct evt_ops *eo = &evtops[i];
 
@@ -444,6 +452,9 @@ EXPORT_API int appcore_init(const char *name, const struct ui_ops *ops,
 	int r;
 	char dirname[PATH_MAX];
 
+	/* the startup tasks fill what is used below */
+	startup_join();
+
 	if (core.state != 0) {
 		_ERR("Already in use");
 		errno = EALREADY;
@@ -456,8 +467,10 @@ EXPORT_API int appcore_init(const char *name, const struct ui_ops *ops,
 		return -1;
 	}
 
+	path_init(argc, argv);
+
 	r = __get_dir_name(dirname);
-	r = set_i18n(name, dirname);
+	r = set_i18n(name, r == 0 ? dirname : NULL);
 	_retv_if(r == -1, -1);
 
 	r = __add_vconf(&core);
@@ -466,6 +479,9 @@ EXPORT_API int appcore_init(const char *name, const struct ui_ops *ops,
 		goto err;
 	}
 
+	/* read after the notifications are added, no change is missed */
+	settings_init();
+
 	r = aul_launch_init(__aul_handler, &core);
 	if (r < 0) {
 		_ERR("Aul init failed: %d", r);
@@ -494,8 +510,11 @@ EXPORT_API void appcore_exit(void)
 {
 	if (core.state) {
 		__del_vconf();
+		settings_exit();
 		__clear(&core);
 	}
+	task_exit();
+	x_exit();
 	aul_finalize();
 }
 
@@ -522,6 +541,7 @@ EXPORT_API int appcore_flush_memory(void)
 		size = flush_fn(SQLITE_FLUSH_MAX);
 	}
 
+	msgcache_flush();
 	malloc_trim(0);
 	/*
 	*Disabled - the impact of stack_trim() is unclear